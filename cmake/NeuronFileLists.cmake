@@ -210,6 +210,7 @@ set(NRNIV_FILE_LIST
     impedanc.cpp
     kschan.cpp
     kssingle.cpp
+    lfp.cpp
     linmod.cpp
     linmod1.cpp
     matrixmap.cpp
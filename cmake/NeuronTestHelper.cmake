@@ -86,13 +86,17 @@
 #    the same arguments here.
 #
 # 3. nrn_add_test_group_comparison(GROUP group_name
-#                                  [REFERENCE_OUTPUT datatype::file.ext ...])
+#                                  [REFERENCE_OUTPUT datatype::file.ext ...]
+#                                  [REFERENCE_GROUPS group_name ...])
 #
 #    Add a test job that runs after all the tests in this group (as defined by
 #    prior calls to nrn_add_test) and compares their output data. The optional
 #    REFERENCE_OUTPUT argument adds reference data files from the repository to
 #    the comparison job with the magic name "reference_file". Paths are
-#    specified relative to the root of the NEURON repository.
+#    specified relative to the root of the NEURON repository. The optional
+#    REFERENCE_GROUPS argument adds the outputs of the tests of other groups,
+#    as "other_group/test_name", e.g. of the same model with the mechanisms
+#    compiled with different NRNIVMODL_ARGS.
 # ~~~
 # Load the cpp_cc_build_time_copy helper function.
 include("${CODING_CONV_CMAKE}/build-time-copy.cmake")
@@ -487,7 +491,7 @@ endfunction()
 function(nrn_add_test_group_comparison)
   # Parse function arguments
   set(oneValueArgs GROUP)
-  set(multiValueArgs REFERENCE_OUTPUT)
+  set(multiValueArgs REFERENCE_OUTPUT REFERENCE_GROUPS)
   cmake_parse_arguments(NRN_ADD_TEST_GROUP_COMPARISON "" "${oneValueArgs}" "${multiValueArgs}"
                         ${ARGN})
   if(NOT DEFINED NRN_ADD_TEST_GROUP_COMPARISON_GROUP)
@@ -551,6 +555,17 @@ function(nrn_add_test_group_comparison)
                            OUTPUT "${test_directory}/${reference_path}")
   endforeach()
 
+  # The outputs and tests of the reference groups, the output entries prefixed by the group name so
+  # that they do not clash with the test names of this group
+  set(test_outputs "${${prefix}_TEST_OUTPUTS}")
+  set(test_dependencies "${${prefix}_TESTS}")
+  foreach(reference_group ${NRN_ADD_TEST_GROUP_COMPARISON_REFERENCE_GROUPS})
+    foreach(output_string ${NRN_TEST_GROUP_${reference_group}_TEST_OUTPUTS})
+      list(APPEND test_outputs "${reference_group}/${output_string}")
+    endforeach()
+    list(APPEND test_dependencies ${NRN_TEST_GROUP_${reference_group}_TESTS})
+  endforeach()
+
   # Copy the comparison script
   cpp_cc_build_time_copy(INPUT "${PROJECT_SOURCE_DIR}/test/scripts/compare_test_results.py"
                          OUTPUT "${test_directory}/compare_test_results.py")
@@ -559,14 +574,13 @@ function(nrn_add_test_group_comparison)
   set(comparison_name "${NRN_ADD_TEST_GROUP_COMPARISON_GROUP}::compare_results")
   add_test(
     NAME ${comparison_name}
-    COMMAND "${test_directory}/compare_test_results.py" ${${prefix}_TEST_OUTPUTS}
-            ${reference_file_string}
+    COMMAND "${test_directory}/compare_test_results.py" ${test_outputs} ${reference_file_string}
     WORKING_DIRECTORY "${test_directory}/${NRN_ADD_TEST_GROUP_COMPARISON_GROUP}")
 
   # Make sure the comparison job declares that it depends on the previous jobs. The comparison job
   # will always run, but the dependencies ensure that it will be sequenced correctly, i.e. it runs
   # after the jobs it is comparing.
-  set_tests_properties(${comparison_name} PROPERTIES DEPENDS "${${prefix}_TESTS}")
+  set_tests_properties(${comparison_name} PROPERTIES DEPENDS "${test_dependencies}")
   # Set up the environment for the test comparison job
   set_tests_properties(${comparison_name} PROPERTIES ENVIRONMENT
                                                      "PATH=${CMAKE_BINARY_DIR}/bin:$ENV{PATH}")
@@ -95,6 +95,9 @@ corenrn_parameters::corenrn_parameters()
                      this->restorepath,
                      "Restore simulation from provided checkpoint directory.")
         ->check(CLI::ExistingDirectory);
+    sub_input->add_flag("--mmap",
+                        this->mmap_input,
+                        "Memory map the dataset files instead of reading them through a stream.");
 
     auto sub_parallel = app.add_option_group("parallel", "Parallel processing options.");
     sub_parallel->add_flag("-c, --threading",
@@ -237,6 +240,7 @@ std::ostream& operator<<(std::ostream& os, const corenrn_parameters& corenrn_par
        << "--pattern=" << corenrn_param.patternstim << std::endl
        << "--report-conf=" << corenrn_param.reportfilepath << std::endl
        << std::left << std::setw(15) << "--restore=" << corenrn_param.restorepath << std::endl
+       << "--mmap=" << (corenrn_param.mmap_input ? "true" : "false") << std::endl
        << std::endl
        << "PARALLEL COMPUTATION PARAMETERS" << std::endl
        << "--threading=" << (corenrn_param.threading ? "true" : "false") << std::endl
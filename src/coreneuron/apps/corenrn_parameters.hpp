@@ -72,6 +72,8 @@ struct corenrn_parameters_data {
 
     bool model_stats = false;  /// Print mechanism counts and model size after initialization
 
+    bool mmap_input = false;  /// Memory map phase files instead of reading through fstream
+
     verbose_level verbose{verbose_level::DEFAULT};  /// Verbosity-level
 
     double tstop = 100;        /// Stop time of simulation in msec
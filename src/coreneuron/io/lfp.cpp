@@ -2,82 +2,18 @@
 #include "coreneuron/apps/corenrn_parameters.hpp"
 
 #include <cmath>
-#include <limits>
-#include <sstream>
-
 
 namespace coreneuron {
-namespace lfputils {
-
-double line_source_lfp_factor(const Point3D& e_pos,
-                              const Point3D& seg_0,
-                              const Point3D& seg_1,
-                              const double radius,
-                              const double f) {
-    nrn_assert(radius >= 0.0);
-    Point3D dx = paxpy(seg_1, -1.0, seg_0);
-    Point3D de = paxpy(e_pos, -1.0, seg_0);
-    double dx2(dot(dx, dx));
-    double dxn(std::sqrt(dx2));
-    if (dxn < std::numeric_limits<double>::epsilon()) {
-        return point_source_lfp_factor(e_pos, seg_0, radius, f);
-    }
-    double de2(dot(de, de));
-    double mu(dot(dx, de) / dx2);
-    Point3D de_star(paxpy(de, -mu, dx));
-    double de_star2(dot(de_star, de_star));
-    double q2(de_star2 / dx2);
-
-    double delta(mu * mu - (de2 - radius * radius) / dx2);
-    double one_m_mu(1.0 - mu);
-    auto log_integral = [&q2, &dxn](double a, double b) {
-        if (q2 < std::numeric_limits<double>::epsilon()) {
-            if (a * b <= 0) {
-                std::ostringstream s;
-                s << "Log integral: invalid arguments " << b << " " << a
-                  << ". Likely electrode exactly on the segment and "
-                  << "no flooring is present.";
-                throw std::invalid_argument(s.str());
-            }
-            return std::abs(std::log(b / a)) / dxn;
-        } else {
-            return std::log((b + std::sqrt(b * b + q2)) / (a + std::sqrt(a * a + q2))) / dxn;
-        }
-    };
-    if (delta <= 0.0) {
-        return f * log_integral(-mu, one_m_mu);
-    } else {
-        double sqr_delta(std::sqrt(delta));
-        double d1(mu - sqr_delta);
-        double d2(mu + sqr_delta);
-        double parts = 0.0;
-        if (d1 > 0.0) {
-            double b(std::min(d1, 1.0) - mu);
-            parts += log_integral(-mu, b);
-        }
-        if (d2 < 1.0) {
-            double b(std::max(d2, 0.0) - mu);
-            parts += log_integral(b, one_m_mu);
-        };
-        // complement
-        double maxd1_0(std::max(d1, 0.0)), mind2_1(std::min(d2, 1.0));
-        if (maxd1_0 < mind2_1) {
-            parts += 1.0 / radius * (mind2_1 - maxd1_0);
-        }
-        return f * parts;
-    };
-}
-}  // namespace lfputils
-
 using namespace lfputils;
 
-template <LFPCalculatorType Type, typename SegmentIdTy>
-LFPCalculator<Type, SegmentIdTy>::LFPCalculator(const Point3Ds& seg_start,
-                                                const Point3Ds& seg_end,
-                                                const std::vector<double>& radius,
-                                                const std::vector<SegmentIdTy>& segment_ids,
-                                                const Point3Ds& electrodes,
-                                                double extra_cellular_conductivity)
+template <LFPCalculatorType Type, typename SegmentIdTy, typename FactorTy>
+LFPCalculator<Type, SegmentIdTy, FactorTy>::LFPCalculator(
+    const Point3Ds& seg_start,
+    const Point3Ds& seg_end,
+    const std::vector<double>& radius,
+    const std::vector<SegmentIdTy>& segment_ids,
+    const Point3Ds& electrodes,
+    double extra_cellular_conductivity)
     : segment_ids_(segment_ids) {
     if (seg_start.size() != seg_end.size()) {
         throw std::invalid_argument("Different number of segment starts and ends.");
@@ -87,55 +23,66 @@ LFPCalculator<Type, SegmentIdTy>::LFPCalculator(const Point3Ds& seg_start,
     }
     double f(1.0 / (extra_cellular_conductivity * 4.0 * pi));
 
-    m.resize(electrodes.size());
+    const size_t nseg = seg_start.size();
+    tile_ = lfp_tile_size(electrodes.size());
+    npadded_ = (electrodes.size() + tile_ - 1) / tile_ * tile_;
+    factors_.assign(npadded_ * nseg, FactorTy(0));
     for (size_t k = 0; k < electrodes.size(); ++k) {
-        auto& ms = m[k];
-        ms.resize(seg_start.size());
-        for (size_t l = 0; l < seg_start.size(); l++) {
-            ms[l] = getFactor(electrodes[k], seg_start[l], seg_end[l], radius[l], f);
+        FactorTy* ms = factors_.data() + (k / tile_) * nseg * tile_ + k % tile_;
+        for (size_t l = 0; l < nseg; l++) {
+            double factor;
+            if constexpr (Type == LineSource) {
+                factor = line_source_lfp_factor(
+                    electrodes[k], seg_start[l], seg_end[l], radius[l], f);
+            } else {
+                factor = point_source_lfp_factor(
+                    electrodes[k], barycenter(seg_start[l], seg_end[l]), radius[l], f);
+            }
+            ms[l * tile_] = static_cast<FactorTy>(factor);
         }
     }
+    currents_.resize(nseg);
+    local_.resize(npadded_);
+    reduced_.resize(npadded_);
+    lfp_values_.resize(electrodes.size());
 }
 
-template <LFPCalculatorType Type, typename SegmentIdTy>
-template <typename Vector>
-inline void LFPCalculator<Type, SegmentIdTy>::lfp(const Vector& membrane_current) {
-    std::vector<double> res(m.size());
-    for (size_t k = 0; k < m.size(); ++k) {
-        res[k] = 0.0;
-        auto& ms = m[k];
-        for (size_t l = 0; l < ms.size(); l++) {
-            res[k] += ms[l] * membrane_current[segment_ids_[l]];
-        }
-    }
+template <LFPCalculatorType Type, typename SegmentIdTy, typename FactorTy>
+LFPCalculator<Type, SegmentIdTy, FactorTy>::~LFPCalculator() {
+    lfp_wait();
+}
+
+template <LFPCalculatorType Type, typename SegmentIdTy, typename FactorTy>
+void LFPCalculator<Type, SegmentIdTy, FactorTy>::start() {
+    // the buffers of the previous reduction are reused
+    lfp_wait();
+    const size_t nseg = currents_.size();
+    const size_t ntile = npadded_ / tile_;
+    lfp_tiles(tile_, nseg, ntile, factors_.data(), currents_.data(), local_.data());
 #if NRNMPI
     if (corenrn_param.mpi_enable) {
-        lfp_values_.resize(res.size());
         int mpi_sum{1};
-        nrnmpi_dbl_allreduce_vec(res.data(), lfp_values_.data(), res.size(), mpi_sum);
-    } else
-#endif
-    {
-        std::swap(res, lfp_values_);
+        nrnmpi_dbl_iallreduce_vec(
+            local_.data(), reduced_.data(), int(local_.size()), mpi_sum, &request_);
+        return;
     }
+#endif
+    std::copy(local_.begin(), local_.begin() + lfp_values_.size(), lfp_values_.begin());
 }
 
+template <LFPCalculatorType Type, typename SegmentIdTy, typename FactorTy>
+void LFPCalculator<Type, SegmentIdTy, FactorTy>::lfp_wait() {
+#if NRNMPI
+    if (request_) {
+        nrnmpi_wait(&request_);
+        std::copy(reduced_.begin(), reduced_.begin() + lfp_values_.size(), lfp_values_.begin());
+    }
+#endif
+}
 
-template LFPCalculator<LineSource>::LFPCalculator(const lfputils::Point3Ds& seg_start,
-                                                  const lfputils::Point3Ds& seg_end,
-                                                  const std::vector<double>& radius,
-                                                  const std::vector<int>& segment_ids,
-                                                  const lfputils::Point3Ds& electrodes,
-                                                  double extra_cellular_conductivity);
-template LFPCalculator<PointSource>::LFPCalculator(const lfputils::Point3Ds& seg_start,
-                                                   const lfputils::Point3Ds& seg_end,
-                                                   const std::vector<double>& radius,
-                                                   const std::vector<int>& segment_ids,
-                                                   const lfputils::Point3Ds& electrodes,
-                                                   double extra_cellular_conductivity);
-template void LFPCalculator<LineSource>::lfp(const DoublePtr& membrane_current);
-template void LFPCalculator<PointSource>::lfp(const DoublePtr& membrane_current);
-template void LFPCalculator<LineSource>::lfp(const std::vector<double>& membrane_current);
-template void LFPCalculator<PointSource>::lfp(const std::vector<double>& membrane_current);
+template struct LFPCalculator<LineSource>;
+template struct LFPCalculator<PointSource>;
+template struct LFPCalculator<LineSource, int, float>;
+template struct LFPCalculator<PointSource, int, float>;
 
 }  // namespace coreneuron
@@ -3,72 +3,25 @@
 #include <array>
 #include <vector>
 
+#include "coreneuron/io/lfp_kernel.hpp"
 #include "coreneuron/mpi/nrnmpi.h"
 #include "coreneuron/nrnconf.h"
 #include "coreneuron/utils/nrn_assert.h"
 
 namespace coreneuron {
 
-namespace lfputils {
-
-using Point3D = std::array<double, 3>;
-using Point3Ds = std::vector<Point3D>;
-using DoublePtr = double*;
-
-inline double dot(const Point3D& p1, const Point3D& p2) {
-    return p1[0] * p2[0] + p1[1] * p2[1] + p1[2] * p2[2];
-}
-
-inline double norm(const Point3D& p1) {
-    return std::sqrt(dot(p1, p1));
-}
-
-inline Point3D barycenter(const Point3D& p1, const Point3D& p2) {
-    return {0.5 * (p1[0] + p2[0]), 0.5 * (p1[1] + p2[1]), 0.5 * (p1[2] + p2[2])};
-}
-
-inline Point3D paxpy(const Point3D& p1, const double alpha, const Point3D& p2) {
-    return {p1[0] + alpha * p2[0], p1[1] + alpha * p2[1], p1[2] + alpha * p2[2]};
-}
-
-/**
- *
- * \param e_pos electrode position
- * \param seg_pos segment position
- * \param radius segment radius
- * \param double conductivity factor 1/([4 pi] * [conductivity])
- * \return Resistance of the medium from the segment to the electrode.
- */
-inline double point_source_lfp_factor(const Point3D& e_pos,
-                                      const Point3D& seg_pos,
-                                      const double radius,
-                                      const double f) {
-    nrn_assert(radius >= 0.0);
-    Point3D es = paxpy(e_pos, -1.0, seg_pos);
-    return f / std::max(norm(es), radius);
-}
-
-/**
- *
- * \param e_pos electrode position
- * \param seg_pos segment position
- * \param radius segment radius
- * \param f conductivity factor 1/([4 pi] * [conductivity])
- * \return Resistance of the medium from the segment to the electrode.
- */
-double line_source_lfp_factor(const Point3D& e_pos,
-                              const Point3D& seg_0,
-                              const Point3D& seg_1,
-                              const double radius,
-                              const double f);
-}  // namespace lfputils
-
 enum LFPCalculatorType { LineSource, PointSource };
 
 /**
  * \brief LFPCalculator allows calculation of LFP given membrane currents.
+ *
+ * The electrode factors are stored in tiles of up to 16 electrodes,
+ * [tile][segment][electrode in tile], so that the partial sums of a tile stay
+ * in registers while the segments are streamed. The membrane currents are
+ * gathered once into a contiguous buffer. FactorTy may be float, which halves
+ * the memory traffic, the sums are always in double.
  */
-template <LFPCalculatorType Ty, typename SegmentIdTy = int>
+template <LFPCalculatorType Ty, typename SegmentIdTy = int, typename FactorTy = double>
 struct LFPCalculator {
     /**
      * LFP Calculator constructor
@@ -86,57 +39,53 @@ struct LFPCalculator {
                   const std::vector<SegmentIdTy>& segment_ids,
                   const lfputils::Point3Ds& electrodes,
                   double extra_cellular_conductivity);
+    ~LFPCalculator();
+    // owns the request of the reduction in flight
+    LFPCalculator(const LFPCalculator&) = delete;
+    LFPCalculator& operator=(const LFPCalculator&) = delete;
+    LFPCalculator(LFPCalculator&&) = delete;
+    LFPCalculator& operator=(LFPCalculator&&) = delete;
+
+    /** compute the LFP and wait for its reduction over the ranks */
+    template <typename Vector>
+    void lfp(const Vector& membrane_current) {
+        lfp_start(membrane_current);
+        lfp_wait();
+    }
 
+    /**
+     * compute the LFP of the segments of this rank and start its reduction
+     * over the ranks, which lfp_wait completes. The integration can go on in
+     * between.
+     */
     template <typename Vector>
-    void lfp(const Vector& membrane_current);
+    void lfp_start(const Vector& membrane_current) {
+        for (size_t l = 0; l < segment_ids_.size(); ++l) {
+            currents_[l] = membrane_current[segment_ids_[l]];
+        }
+        start();
+    }
+    void lfp_wait();
 
     const std::vector<double>& lfp_values() const noexcept {
         return lfp_values_;
     }
 
   private:
-    inline double getFactor(const lfputils::Point3D& e_pos,
-                            const lfputils::Point3D& seg_0,
-                            const lfputils::Point3D& seg_1,
-                            const double radius,
-                            const double f) const;
+    void start();
     std::vector<double> lfp_values_;
-    std::vector<std::vector<double>> m;
+    std::vector<FactorTy> factors_;
+    std::vector<double> currents_;  // gathered membrane currents
+    std::vector<double> local_;     // sums of this rank, npadded_ values
+    std::vector<double> reduced_;   // sums over the ranks
+    std::size_t tile_{1};           // electrodes per tile
+    std::size_t npadded_{};         // electrodes rounded up to tiles
+    void* request_{};               // reduction in flight
     const std::vector<SegmentIdTy>& segment_ids_;
 };
 
-template <>
-inline double LFPCalculator<LineSource>::getFactor(const lfputils::Point3D& e_pos,
-                                                   const lfputils::Point3D& seg_0,
-                                                   const lfputils::Point3D& seg_1,
-                                                   const double radius,
-                                                   const double f) const {
-    return lfputils::line_source_lfp_factor(e_pos, seg_0, seg_1, radius, f);
-}
-
-template <>
-inline double LFPCalculator<PointSource>::getFactor(const lfputils::Point3D& e_pos,
-                                                    const lfputils::Point3D& seg_0,
-                                                    const lfputils::Point3D& seg_1,
-                                                    const double radius,
-                                                    const double f) const {
-    return lfputils::point_source_lfp_factor(e_pos, lfputils::barycenter(seg_0, seg_1), radius, f);
-}
-
-extern template LFPCalculator<LineSource>::LFPCalculator(const lfputils::Point3Ds& seg_start,
-                                                         const lfputils::Point3Ds& seg_end,
-                                                         const std::vector<double>& radius,
-                                                         const std::vector<int>& segment_ids,
-                                                         const lfputils::Point3Ds& electrodes,
-                                                         double extra_cellular_conductivity);
-extern template LFPCalculator<PointSource>::LFPCalculator(const lfputils::Point3Ds& seg_start,
-                                                          const lfputils::Point3Ds& seg_end,
-                                                          const std::vector<double>& radius,
-                                                          const std::vector<int>& segment_ids,
-                                                          const lfputils::Point3Ds& electrodes,
-                                                          double extra_cellular_conductivity);
-extern template void LFPCalculator<LineSource>::lfp(const lfputils::DoublePtr& membrane_current);
-extern template void LFPCalculator<PointSource>::lfp(const lfputils::DoublePtr& membrane_current);
-extern template void LFPCalculator<LineSource>::lfp(const std::vector<double>& membrane_current);
-extern template void LFPCalculator<PointSource>::lfp(const std::vector<double>& membrane_current);
+extern template struct LFPCalculator<LineSource>;
+extern template struct LFPCalculator<PointSource>;
+extern template struct LFPCalculator<LineSource, int, float>;
+extern template struct LFPCalculator<PointSource, int, float>;
 }  // namespace coreneuron
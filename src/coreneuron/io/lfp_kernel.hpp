@@ -0,0 +1,192 @@
+#pragma once
+
+// The LFP transfer factors and the tiled electrode x segment product. Only
+// depends on the standard library, it is shared by the CoreNEURON
+// LFPCalculator and the NEURON LFP class.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace coreneuron {
+
+namespace lfputils {
+
+using Point3D = std::array<double, 3>;
+using Point3Ds = std::vector<Point3D>;
+using DoublePtr = double*;
+
+inline double dot(const Point3D& p1, const Point3D& p2) {
+    return p1[0] * p2[0] + p1[1] * p2[1] + p1[2] * p2[2];
+}
+
+inline double norm(const Point3D& p1) {
+    return std::sqrt(dot(p1, p1));
+}
+
+inline Point3D barycenter(const Point3D& p1, const Point3D& p2) {
+    return {0.5 * (p1[0] + p2[0]), 0.5 * (p1[1] + p2[1]), 0.5 * (p1[2] + p2[2])};
+}
+
+inline Point3D paxpy(const Point3D& p1, const double alpha, const Point3D& p2) {
+    return {p1[0] + alpha * p2[0], p1[1] + alpha * p2[1], p1[2] + alpha * p2[2]};
+}
+
+/**
+ *
+ * \param e_pos electrode position
+ * \param seg_pos segment position
+ * \param radius segment radius
+ * \param double conductivity factor 1/([4 pi] * [conductivity])
+ * \return Resistance of the medium from the segment to the electrode.
+ */
+inline double point_source_lfp_factor(const Point3D& e_pos,
+                                      const Point3D& seg_pos,
+                                      const double radius,
+                                      const double f) {
+    if (radius < 0.0) {
+        throw std::invalid_argument("Negative segment radius.");
+    }
+    Point3D es = paxpy(e_pos, -1.0, seg_pos);
+    return f / std::max(norm(es), radius);
+}
+
+/**
+ *
+ * \param e_pos electrode position
+ * \param seg_pos segment position
+ * \param radius segment radius
+ * \param f conductivity factor 1/([4 pi] * [conductivity])
+ * \return Resistance of the medium from the segment to the electrode.
+ */
+inline double line_source_lfp_factor(const Point3D& e_pos,
+                                     const Point3D& seg_0,
+                                     const Point3D& seg_1,
+                                     const double radius,
+                                     const double f) {
+    if (radius < 0.0) {
+        throw std::invalid_argument("Negative segment radius.");
+    }
+    Point3D dx = paxpy(seg_1, -1.0, seg_0);
+    Point3D de = paxpy(e_pos, -1.0, seg_0);
+    double dx2(dot(dx, dx));
+    double dxn(std::sqrt(dx2));
+    if (dxn < std::numeric_limits<double>::epsilon()) {
+        return point_source_lfp_factor(e_pos, seg_0, radius, f);
+    }
+    double de2(dot(de, de));
+    double mu(dot(dx, de) / dx2);
+    Point3D de_star(paxpy(de, -mu, dx));
+    double de_star2(dot(de_star, de_star));
+    double q2(de_star2 / dx2);
+
+    double delta(mu * mu - (de2 - radius * radius) / dx2);
+    double one_m_mu(1.0 - mu);
+    auto log_integral = [&q2, &dxn](double a, double b) {
+        if (q2 < std::numeric_limits<double>::epsilon()) {
+            if (a * b <= 0) {
+                std::ostringstream s;
+                s << "Log integral: invalid arguments " << b << " " << a
+                  << ". Likely electrode exactly on the segment and "
+                  << "no flooring is present.";
+                throw std::invalid_argument(s.str());
+            }
+            return std::abs(std::log(b / a)) / dxn;
+        } else {
+            return std::log((b + std::sqrt(b * b + q2)) / (a + std::sqrt(a * a + q2))) / dxn;
+        }
+    };
+    if (delta <= 0.0) {
+        return f * log_integral(-mu, one_m_mu);
+    } else {
+        double sqr_delta(std::sqrt(delta));
+        double d1(mu - sqr_delta);
+        double d2(mu + sqr_delta);
+        double parts = 0.0;
+        if (d1 > 0.0) {
+            double b(std::min(d1, 1.0) - mu);
+            parts += log_integral(-mu, b);
+        }
+        if (d2 < 1.0) {
+            double b(std::max(d2, 0.0) - mu);
+            parts += log_integral(b, one_m_mu);
+        };
+        // complement
+        double maxd1_0(std::max(d1, 0.0)), mind2_1(std::min(d2, 1.0));
+        if (maxd1_0 < mind2_1) {
+            parts += 1.0 / radius * (mind2_1 - maxd1_0);
+        }
+        return f * parts;
+    };
+}
+
+/** electrodes per tile for nelectrode electrodes, a power of 2 up to 16 */
+inline std::size_t lfp_tile_size(std::size_t nelectrode) {
+    std::size_t tile = 1;
+    while (tile < 16 && tile < nelectrode) {
+        tile *= 2;
+    }
+    return tile;
+}
+
+// out[e] = sum over segments of factor * current, for each tile of W
+// electrodes
+template <std::size_t W, typename FactorTy>
+void lfp_tile_kernel(std::size_t nseg,
+                     std::size_t ntile,
+                     const FactorTy* factors,
+                     const double* currents,
+                     double* out) {
+    for (std::size_t tile = 0; tile < ntile; ++tile) {
+        double acc[W] = {};
+        const FactorTy* f = factors + tile * nseg * W;
+        for (std::size_t l = 0; l < nseg; ++l) {
+            const double c = currents[l];
+            for (std::size_t e = 0; e < W; ++e) {
+                acc[e] += f[l * W + e] * c;
+            }
+        }
+        for (std::size_t e = 0; e < W; ++e) {
+            out[tile * W + e] = acc[e];
+        }
+    }
+}
+
+/**
+ * \brief out[e] = sum over the nseg segments of factor * current
+ *
+ * \param tile electrodes per tile, from lfp_tile_size
+ * \param factors [tile][segment][electrode in tile]
+ * \param out ntile * tile values
+ */
+template <typename FactorTy>
+void lfp_tiles(std::size_t tile,
+               std::size_t nseg,
+               std::size_t ntile,
+               const FactorTy* factors,
+               const double* currents,
+               double* out) {
+    switch (tile) {
+    case 1:
+        lfp_tile_kernel<1>(nseg, ntile, factors, currents, out);
+        break;
+    case 2:
+        lfp_tile_kernel<2>(nseg, ntile, factors, currents, out);
+        break;
+    case 4:
+        lfp_tile_kernel<4>(nseg, ntile, factors, currents, out);
+        break;
+    case 8:
+        lfp_tile_kernel<8>(nseg, ntile, factors, currents, out);
+        break;
+    default:
+        lfp_tile_kernel<16>(nseg, ntile, factors, currents, out);
+    }
+}
+}  // namespace lfputils
+}  // namespace coreneuron
@@ -6,7 +6,12 @@
 # =============================================================================.
 */
 
+#include <algorithm>
 #include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "coreneuron/apps/corenrn_parameters.hpp"
 #include "coreneuron/io/nrn_filehandler.hpp"
 #include "coreneuron/nrnconf.h"
 
@@ -22,15 +27,109 @@ bool FileHandler::file_exist(const std::string& filename) {
     return (stat(filename.c_str(), &buffer) == 0);
 }
 
+void FileHandler::prefetch(const std::string& filename) {
+#if defined(POSIX_FADV_WILLNEED)
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        ::close(fd);
+    }
+#endif
+}
+
+bool FileHandler::map_file(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    void* p = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        return false;
+    }
+    madvise(p, st.st_size, MADV_SEQUENTIAL);
+    map_ = static_cast<const char*>(p);
+    map_size_ = st.st_size;
+    map_pos_ = 0;
+    map_released_ = 0;
+    return true;
+}
+
+void FileHandler::release_consumed() {
+    // Not worth a system call for less than this.
+    constexpr std::size_t release_chunk = 1 << 22;
+    if (map_pos_ - map_released_ < release_chunk) {
+        return;
+    }
+    static const std::size_t page = sysconf(_SC_PAGESIZE);
+    std::size_t end = map_pos_ / page * page;
+    madvise(const_cast<char*>(map_) + map_released_, end - map_released_, MADV_DONTNEED);
+    map_released_ = end;
+}
+
+bool FileHandler::getline(char* buf, std::size_t size) {
+    if (!map_) {
+        F.getline(buf, size);
+        return !F.fail();
+    }
+    std::size_t n = std::min(size, map_size_ - map_pos_);
+    const char* begin = map_ + map_pos_;
+    auto* nl = static_cast<const char*>(memchr(begin, '\n', n));
+    if (nl) {
+        n = nl - begin;
+    } else if (n == 0 || n == size) {
+        return false;  // end of file, or the line does not fit in buf
+    }
+    // else, as std::istream::getline, the end of the file ends the last line
+    memcpy(buf, begin, n);
+    buf[n] = '\0';
+    map_pos_ = std::min(map_pos_ + n + 1, map_size_);
+    return true;
+}
+
+void FileHandler::read_bytes(char* p, std::size_t n) {
+    if (!map_) {
+        F.read(p, n);
+        nrn_assert(!F.fail());
+        return;
+    }
+    nrn_assert(n <= map_size_ - map_pos_);
+    memcpy(p, map_ + map_pos_, n);
+    map_pos_ += n;
+    release_consumed();
+}
+
+void FileHandler::skip_bytes(std::size_t n) {
+    if (!map_) {
+        F.seekg(n, std::ios_base::cur);
+        nrn_assert(!F.fail());
+        return;
+    }
+    nrn_assert(n <= map_size_ - map_pos_);
+    map_pos_ += n;
+    release_consumed();
+}
+
 void FileHandler::open(const std::string& filename, std::ios::openmode mode) {
     nrn_assert((mode & (std::ios::in | std::ios::out)));
     close();
+    current_mode = mode;
+    if (mode == std::ios::in && corenrn_param.mmap_input && map_file(filename)) {
+        char version[256];
+        nrn_assert(getline(version, sizeof(version)));
+        check_bbcore_write_version(version);
+        return;
+    }
     F.open(filename, mode | std::ios::binary);
     if (!F.is_open()) {
         std::cerr << "cannot open file '" << filename << "'" << std::endl;
     }
     nrn_assert(F.is_open());
-    current_mode = mode;
     char version[256];
     if (current_mode & std::ios::in) {
         F.getline(version, sizeof(version));
@@ -43,6 +142,9 @@ void FileHandler::open(const std::string& filename, std::ios::openmode mode) {
 }
 
 bool FileHandler::eof() {
+    if (map_) {
+        return map_pos_ >= map_size_;
+    }
     if (F.eof()) {
         return true;
     }
@@ -57,8 +159,7 @@ bool FileHandler::eof() {
 int FileHandler::read_int() {
     char line_buf[max_line_length];
 
-    F.getline(line_buf, sizeof(line_buf));
-    nrn_assert(!F.fail());
+    nrn_assert(getline(line_buf, sizeof(line_buf)));
 
     int i;
     int n_scan = sscanf(line_buf, "%d", &i);
@@ -70,8 +171,7 @@ int FileHandler::read_int() {
 void FileHandler::read_mapping_count(int* gid, int* nsec, int* nseg, int* nseclist) {
     char line_buf[max_line_length];
 
-    F.getline(line_buf, sizeof(line_buf));
-    nrn_assert(!F.fail());
+    nrn_assert(getline(line_buf, sizeof(line_buf)));
 
     /** mapping file has extra strings, ignore those */
     int n_scan = sscanf(line_buf, "%d %d %d %d", gid, nsec, nseg, nseclist);
@@ -85,8 +185,7 @@ void FileHandler::read_mapping_cell_count(int* count) {
 void FileHandler::read_checkpoint_assert() {
     char line_buf[max_line_length];
 
-    F.getline(line_buf, sizeof(line_buf));
-    nrn_assert(!F.fail());
+    nrn_assert(getline(line_buf, sizeof(line_buf)));
 
     int i;
     int n_scan = sscanf(line_buf, "chkpnt %d\n", &i);
@@ -102,6 +201,11 @@ void FileHandler::read_checkpoint_assert() {
 }
 
 void FileHandler::close() {
+    if (map_) {
+        munmap(const_cast<char*>(map_), map_size_);
+        map_ = nullptr;
+        map_size_ = map_pos_ = map_released_ = 0;
+    }
     F.close();
 }
 }  // namespace coreneuron
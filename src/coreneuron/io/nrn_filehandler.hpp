@@ -12,6 +12,8 @@
 #include <fstream>
 #include <vector>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <sys/stat.h>
 
 #include "coreneuron/utils/nrn_assert.h"
@@ -26,6 +28,12 @@ namespace coreneuron {
  *
  * All automatic allocations performed by read_int_array()
  * and read_dbl_array() methods use new [].
+ *
+ * With corenrn_param.mmap_input, files opened for reading are memory mapped
+ * instead of going through a std::fstream. Arrays are then copied once,
+ * straight from the page cache into their destination, and pages behind the
+ * read position are handed back to the kernel so that a file does not stay
+ * resident while the model built from it grows.
  */
 
 // @todo: remove this static buffer
@@ -36,6 +44,21 @@ class FileHandler {
     std::ios_base::openmode current_mode;  //!< File open mode (not stored in fstream)
     int chkpnt;                            //!< Current checkpoint number state.
     int stored_chkpnt;                     //!< last "remembered" checkpoint number state.
+    const char* map_ = nullptr;            //!< Read only mapping of the file, or nullptr.
+    std::size_t map_size_ = 0;             //!< Size of the mapping in bytes.
+    std::size_t map_pos_ = 0;              //!< Read position in the mapping.
+    std::size_t map_released_ = 0;         //!< Mapping before this offset has been released.
+    /** Memory map filename for reading. False if not possible. */
+    bool map_file(const std::string& filename);
+    /** Return fully consumed pages of the mapping to the kernel. */
+    void release_consumed();
+    /** Read a line, without the newline, into buf. False if there is no
+     * complete line of less than size characters. */
+    bool getline(char* buf, std::size_t size);
+    /** Copy the next n bytes into p. */
+    void read_bytes(char* p, std::size_t n);
+    /** Skip the next n bytes. */
+    void skip_bytes(std::size_t n);
     /** Read a checkpoint line, bump our chkpnt counter, and assert equality.
      *
      * Checkpoint information is represented by a sequence "checkpt %d\n"
@@ -55,16 +78,28 @@ class FileHandler {
 
     explicit FileHandler(const std::string& filename);
 
+    ~FileHandler() {
+        close();
+    }
+
     /** Preserving chkpnt state, move to a new file. */
     void open(const std::string& filename, std::ios::openmode mode = std::ios::in);
 
     /** Is the file not open */
     bool fail() const {
-        return F.fail();
+        return !map_ && F.fail();
+    }
+
+    /** Is the file memory mapped */
+    bool mapped() const {
+        return map_ != nullptr;
     }
 
     static bool file_exist(const std::string& filename);
 
+    /** Hint the kernel to start reading filename in the background. */
+    static void prefetch(const std::string& filename);
+
     /** nothing more to read */
     bool eof();
 
@@ -118,7 +153,7 @@ class FileHandler {
         int num_electrodes;
         char line_buf[max_line_length], name[max_line_length];
 
-        F.getline(line_buf, sizeof(line_buf));
+        nrn_assert(getline(line_buf, sizeof(line_buf)));
         n_scan = sscanf(
             line_buf, "%s %d %d %zd %d", name, &nsec, &nseg, &total_lfp_factors, &num_electrodes);
 
@@ -182,14 +217,12 @@ class FileHandler {
         read_checkpoint_assert();
         switch (flag) {
         case seek:
-            F.seekg(count * sizeof(T), std::ios_base::cur);
+            skip_bytes(count * sizeof(T));
             break;
         case read:
-            F.read((char*) p, count * sizeof(T));
+            read_bytes((char*) p, count * sizeof(T));
             break;
         }
-
-        nrn_assert(!F.fail());
         return p;
     }
 
@@ -16,6 +16,10 @@
 #include "coreneuron/io/mem_layout_util.hpp"
 #include "coreneuron/io/nrn_checkpoint.hpp"
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 namespace coreneuron {
 void read_phase1(NrnThread& nt, UserParams& userParams);
 void read_phase2(NrnThread& nt, UserParams& userParams);
@@ -100,24 +104,36 @@ inline void read_phase_aux<gap>(NrnThread& nt, UserParams& userParams) {
     read_phasegap(nt, userParams);
 }
 
+template <phase P>
+inline std::string phase_filename(UserParams& userParams, int i) {
+    // directory to read could be different for phase 2 if we are restoring
+    // all other phases still read from dataset directory because the data
+    // is constant
+    const char* data_dir = P == 2 ? userParams.restore_path : userParams.path;
+    return std::string(data_dir) + "/" + std::to_string(userParams.gidgroups[i]) + "_" +
+           getPhaseName<P>() + ".dat";
+}
+
 /// Reading phase wrapper for each neuron group.
 template <phase P>
 inline void* phase_wrapper_w(NrnThread* nt, UserParams& userParams, bool in_memory_transfer) {
     int i = nt->id;
     if (i < userParams.ngroup) {
         if (!in_memory_transfer) {
-            const char* data_dir = userParams.path;
-            // directory to read could be different for phase 2 if we are restoring
-            // all other phases still read from dataset directory because the data
-            // is constant
-            if (P == 2) {
-                data_dir = userParams.restore_path;
+            std::string fname = phase_filename<P>(userParams, i);
+
+            // Groups are claimed in order, so the group this thread most
+            // likely reads next is one team size ahead. Have the kernel read
+            // it while this one is parsed and populated.
+#if defined(_OPENMP)
+            int next = i + omp_get_num_threads();
+#else
+            int next = i + 1;
+#endif
+            if (next < userParams.ngroup) {
+                FileHandler::prefetch(phase_filename<P>(userParams, next));
             }
 
-            std::string fname = std::string(data_dir) + "/" +
-                                std::to_string(userParams.gidgroups[i]) + "_" + getPhaseName<P>() +
-                                ".dat";
-
             // Avoid trying to open the gid_gap.dat file if it doesn't exist when there are no
             // gap junctions in this gid.
             // Note that we still need to close `userParams.file_reader[i]`
@@ -142,10 +158,11 @@ inline void* phase_wrapper_w(NrnThread* nt, UserParams& userParams, bool in_memo
     return nullptr;
 }
 
-/// Specific phase reading executed by threads.
+/// Specific phase reading executed by threads. Cell groups can differ a lot
+/// in size, so they are distributed dynamically.
 template <phase P>
 inline static void phase_wrapper(UserParams& userParams, int direct = 0) {
-    nrn_multithread_job(phase_wrapper_w<P>, userParams, direct != 0);
+    nrn_multithread_job_dynamic(phase_wrapper_w<P>, userParams, direct != 0);
 }
 }  // namespace coreneuron
 }  // namespace coreneuron
@@ -990,13 +990,14 @@ void Phase2::populate(NrnThread& nt, const UserParams& userParams) {
     auto& nrn_prop_param_size_ = corenrn.get_prop_param_size();
     auto& nrn_prop_dparam_size_ = corenrn.get_prop_dparam_size();
 
-/* read_phase2 is being called from openmp region
- * and hence we can set the stream equal to current thread id.
+/* read_phase2 is being called from openmp region. Cell groups are read
+ * with a dynamic schedule, so set the stream to the thread that will run
+ * this NrnThread under the schedule(static, 1) of nrn_multithread_job.
  * In fact we could set gid as stream_id when we will have nrn threads
  * greater than number of omp threads.
  */
 #if defined(_OPENMP)
-    nt.stream_id = omp_get_thread_num();
+    nt.stream_id = nt.id % omp_get_num_threads();
 #endif
 
     int shadow_rhs_cnt = 0;
@@ -30,6 +30,37 @@ namespace coreneuron {
 // Size in MB of the report buffer
 static int size_report_buffer = 4;
 
+void SummationReport::build_csr(size_t nnode) {
+    summation_.resize(nnode, 0.0);
+    segments_.clear();
+    offsets_.assign(1, 0);
+    current_ptrs_.clear();
+    scales_.clear();
+    for (const auto& kv: currents_) {
+        segments_.push_back(kv.first);
+    }
+    // segment order for a sequential walk over summation_
+    std::sort(segments_.begin(), segments_.end());
+    for (const auto& segment_id: segments_) {
+        for (const auto& value: currents_.at(segment_id)) {
+            current_ptrs_.push_back(value.first);
+            scales_.push_back(value.second);
+        }
+        offsets_.push_back(current_ptrs_.size());
+    }
+}
+
+void SummationReport::sum_currents() {
+    const size_t nsegment = segments_.size();
+    for (size_t i = 0; i < nsegment; ++i) {
+        double sum = 0.0;
+        for (size_t j = offsets_[i]; j < offsets_[i + 1]; ++j) {
+            sum += *current_ptrs_[j] * scales_[j];
+        }
+        summation_[segments_[i]] = sum;
+    }
+}
+
 void nrn_flush_reports(double t) {
     // flush before buffer is full
 #ifdef ENABLE_SONATA_REPORTS
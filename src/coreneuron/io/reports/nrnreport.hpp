@@ -32,6 +32,18 @@ struct SummationReport {
     std::unordered_map<size_t, std::vector<std::pair<double*, int>>> currents_;
     // Map containing the list of segment_ids per gid
     std::unordered_map<int, std::vector<size_t>> gid_segments_;
+    // currents_ flattened by build_csr(): the currents of segments_[i] and
+    // their scaling factors are at [offsets_[i], offsets_[i + 1])
+    std::vector<size_t> segments_;
+    std::vector<size_t> offsets_;
+    std::vector<double*> current_ptrs_;
+    std::vector<double> scales_;
+
+    // Flatten currents_ once all the currents are registered and size
+    // summation_ for nnode segments, those without currents summing to 0
+    void build_csr(size_t nnode);
+    // Sum the scaled currents of every segment into summation_
+    void sum_currents();
 };
 
 struct SummationReportMapping {
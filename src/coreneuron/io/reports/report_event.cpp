@@ -43,16 +43,7 @@ ReportEvent::ReportEvent(double dt,
 void ReportEvent::summation_alu(NrnThread* nt) {
     auto& summation_report = nt->summation_report_handler_->summation_reports_[report_path];
     // Add currents of all variables in each segment
-    for (const auto& kv: summation_report.currents_) {
-        double sum = 0.0;
-        int segment_id = kv.first;
-        for (const auto& value: kv.second) {
-            double current_value = *value.first;
-            int scale = value.second;
-            sum += current_value * scale;
-        }
-        summation_report.summation_[segment_id] = sum;
-    }
+    summation_report.sum_currents();
     // Add all currents in the soma
     // Only when type summation and soma target
     if (!summation_report.gid_segments_.empty()) {
@@ -71,6 +62,9 @@ void ReportEvent::lfp_calc(NrnThread* nt) {
     auto* mapinfo = static_cast<NrnThreadMappingInfo*>(nt->mapping);
     double* fast_imem_rhs = nt->nrn_fast_imem->nrn_sav_rhs;
     auto& summation_report = nt->summation_report_handler_->summation_reports_[report_path];
+    // currents of each segment, summed once for all the electrodes
+    summation_report.sum_currents();
+    const double* iclamp = summation_report.summation_.data();
     for (const auto& kv: vars_to_report) {
         int gid = kv.first;
         const auto& to_report = kv.second;
@@ -80,15 +74,10 @@ void ReportEvent::lfp_calc(NrnThread* nt) {
         for (const auto& kv: cell_mapping->lfp_factors) {
             int segment_id = kv.first;
             const auto& factors = kv.second;
+            const double current = fast_imem_rhs[segment_id] + iclamp[segment_id];
             int electrode_id = 0;
             for (const auto& factor: factors) {
-                double iclamp = 0.0;
-                for (const auto& value: summation_report.currents_[segment_id]) {
-                    double current_value = *value.first;
-                    int scale = value.second;
-                    iclamp += current_value * scale;
-                }
-                lfp_values[electrode_id] += (fast_imem_rhs[segment_id] + iclamp) * factor;
+                lfp_values[electrode_id] += current * factor;
                 electrode_id++;
             }
         }
@@ -100,27 +89,24 @@ void ReportEvent::lfp_calc(NrnThread* nt) {
 
 /** on deliver, call ReportingLib and setup next event */
 void ReportEvent::deliver(double t, NetCvode* nc, NrnThread* nt) {
-/* libsonata is not thread safe */
-#pragma omp critical
-    {
-        // Sum currents and calculate lfp only on reporting steps
-        if (step > 0 && (static_cast<int>(step) % reporting_period) == 0) {
-            if (report_type == ReportType::SummationReport) {
-                summation_alu(nt);
-            } else if (report_type == ReportType::LFPReport) {
-                lfp_calc(nt);
-            }
+    // Sum currents and calculate lfp only on reporting steps. The event, the
+    // summation report and the lfp buffer belong to this thread, so the threads
+    // compute their reports concurrently.
+    if (step > 0 && (static_cast<int>(step) % reporting_period) == 0) {
+        if (report_type == ReportType::SummationReport) {
+            summation_alu(nt);
+        } else if (report_type == ReportType::LFPReport) {
+            lfp_calc(nt);
         }
-        // each thread needs to know its own step
+    }
+    // each thread needs to know its own step
 #ifdef ENABLE_SONATA_REPORTS
-        sonata_record_node_data(step,
-                                gids_to_report.size(),
-                                gids_to_report.data(),
-                                report_path.data());
+/* libsonata is not thread safe */
+#pragma omp critical
+    sonata_record_node_data(step, gids_to_report.size(), gids_to_report.data(), report_path.data());
 #endif
-        send(t + dt, nc, nt);
-        step++;
-    }
+    send(t + dt, nc, nt);
+    step++;
 }
 
 bool ReportEvent::require_checkpoint() {
@@ -306,6 +306,7 @@ VarsToReport ReportHandler::get_summation_vars_to_report(
         }
         vars_to_report[gid] = to_report;
     }
+    summation_report.build_csr(nt.end);
     return vars_to_report;
 }
 
@@ -385,6 +386,7 @@ VarsToReport ReportHandler::get_lfp_vars_to_report(const NrnThread& nt,
             vars_to_report[gid] = to_report;
         }
     }
+    summation_report.build_csr(nt.end);
     return vars_to_report;
 }
 
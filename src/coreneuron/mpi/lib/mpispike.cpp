@@ -310,6 +310,20 @@ void nrnmpi_dbl_allreduce_vec_impl(double* src, double* dest, int cnt, int type)
     MPI_Allreduce(src, dest, cnt, MPI_DOUBLE, type2OP(type), nrnmpi_comm);
 }
 
+void nrnmpi_dbl_iallreduce_vec_impl(double* src, double* dest, int cnt, int type, void** request) {
+    assert(src != dest);
+    auto* r = new MPI_Request;
+    MPI_Iallreduce(src, dest, cnt, MPI_DOUBLE, type2OP(type), nrnmpi_comm, r);
+    *request = r;
+}
+
+void nrnmpi_wait_impl(void** request) {
+    auto* r = static_cast<MPI_Request*>(*request);
+    MPI_Wait(r, MPI_STATUS_IGNORE);
+    delete r;
+    *request = nullptr;
+}
+
 void nrnmpi_long_allreduce_vec_impl(long* src, long* dest, int cnt, int type) {
     assert(src != dest);
     MPI_Allreduce(src, dest, cnt, MPI_LONG, type2OP(type), nrnmpi_comm);
@@ -84,6 +84,15 @@ extern "C" double nrnmpi_dbl_allreduce_impl(double x, int type);
 declare_mpi_method(nrnmpi_dbl_allreduce);
 extern "C" void nrnmpi_dbl_allreduce_vec_impl(double* src, double* dest, int cnt, int type);
 declare_mpi_method(nrnmpi_dbl_allreduce_vec);
+// non-blocking, *request is set until nrnmpi_wait completes it
+extern "C" void nrnmpi_dbl_iallreduce_vec_impl(double* src,
+                                               double* dest,
+                                               int cnt,
+                                               int type,
+                                               void** request);
+declare_mpi_method(nrnmpi_dbl_iallreduce_vec);
+extern "C" void nrnmpi_wait_impl(void** request);
+declare_mpi_method(nrnmpi_wait);
 extern "C" void nrnmpi_long_allreduce_vec_impl(long* src, long* dest, int cnt, int type);
 declare_mpi_method(nrnmpi_long_allreduce_vec);
 extern "C" bool nrnmpi_initialized_impl();
@@ -171,6 +171,22 @@ void nrn_multithread_job(F&& job, Args&&... args) {
     // clang-format on
 }
 
+/// As nrn_multithread_job but each thread takes the next unclaimed NrnThread
+/// when it finishes one. For jobs whose cost differs a lot between threads,
+/// e.g. reading cell groups of different size.
+template <typename F, typename... Args>
+void nrn_multithread_job_dynamic(F&& job, Args&&... args) {
+    int i;
+    // clang-format off
+
+    #pragma omp parallel for private(i) shared(nrn_threads, job, nrn_nthread, \
+                                           nrnmpi_myid) schedule(dynamic, 1)
+    for (i = 0; i < nrn_nthread; ++i) {
+        job(nrn_threads + i, std::forward<Args>(args)...);
+    }
+    // clang-format on
+}
+
 extern void nrn_thread_table_check(void);
 
 extern void nrn_threads_free(void);
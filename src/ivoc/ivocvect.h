@@ -57,6 +57,16 @@ class IvocVect {
         vec_.resize(n, fill_value);
     }
 
+    // Capacity for at least n elements, at least doubling when it grows. For
+    // appending to vec() without notifying on each resize, only when the data
+    // actually moves.
+    inline void grow_capacity(size_t n) {
+        if (n > vec_.capacity()) {
+            notify_freed_val_array(vec_.data(), vec_.size());
+            vec_.reserve(std::max(n, 2 * vec_.capacity()));
+        }
+    }
+
     inline double& operator[](size_t index) {
         return vec_.at(index);
     }
@@ -8,6 +8,9 @@
     p.setval(i, value)
     p.scatter(Vector)
     p.gather(Vector)
+    p.record(Vector [, "file", chunk])  every step, all values appended to Vector
+    p.record_flush()
+    p.record_remove()
 */
 #include "classreg.h"
 #include "oc2iv.h"
@@ -20,6 +23,10 @@
 #include "gui-redirect.h"
 
 extern int hoc_return_type_code;
+extern void nrn_ptrvec_record(OcPtrVector*, Vect*, const char*, std::size_t);
+extern void nrn_ptrvec_record_flush(OcPtrVector*);
+extern void nrn_ptrvec_record_remove(OcPtrVector*);
+extern void nrn_ptrvec_record_resize(OcPtrVector*);
 
 static double dummy;
 
@@ -29,6 +36,7 @@ OcPtrVector::OcPtrVector(std::size_t sz)
     : pd_{sz, neuron::container::data_handle<double>{neuron::container::do_not_search, &dummy}} {}
 
 OcPtrVector::~OcPtrVector() {
+    nrn_ptrvec_record_remove(this);
     if (label_) {
         free(label_);
     }  // allocated by strdup
@@ -37,6 +45,7 @@ OcPtrVector::~OcPtrVector() {
 void OcPtrVector::resize(int sz) {
     pd_.resize(sz,
                neuron::container::data_handle<double>{neuron::container::do_not_search, &dummy});
+    nrn_ptrvec_record_resize(this);
 }
 
 void OcPtrVector::pset(int i, neuron::container::data_handle<double> dh) {
@@ -129,6 +138,31 @@ static double gather(void* v) {
     return 0.;
 }
 
+static double record(void* v) {
+    OcPtrVector* opv = (OcPtrVector*) v;
+    Vect* y = vector_arg(1);
+    const char* fname = nullptr;
+    std::size_t chunk = 0;
+    if (ifarg(2)) {
+        fname = gargstr(2);
+        if (ifarg(3)) {
+            chunk = std::size_t(chkarg(3, 1., 1e9));
+        }
+    }
+    nrn_ptrvec_record(opv, y, fname, chunk);
+    return 0.;
+}
+
+static double record_flush(void* v) {
+    nrn_ptrvec_record_flush((OcPtrVector*) v);
+    return 0.;
+}
+
+static double record_remove(void* v) {
+    nrn_ptrvec_record_remove((OcPtrVector*) v);
+    return 0.;
+}
+
 //  a copy of ivocvect::v_plot with y+i replaced by y[i]
 static int narg() {
     int i = 0;
@@ -206,6 +240,9 @@ static Member_func members[] = {{"size", get_size},
                                 {"scatter", scatter},
                                 {"gather", gather},
                                 {"plot", ptr_plot},
+                                {"record", record},
+                                {"record_flush", record_flush},
+                                {"record_remove", record_remove},
                                 {nullptr, nullptr}};
 
 static Member_ret_str_func retstr_members[] = {{"label", ptr_label}, {nullptr, nullptr}};
@@ -295,6 +295,11 @@ bool CodegenCoreneuronCppVisitor::optimize_ion_variable_copies() const {
 }
 
 
+bool CodegenCoreneuronCppVisitor::simd_function_hints() const {
+    return enable_simd;
+}
+
+
 void CodegenCoreneuronCppVisitor::print_memory_allocation_routine() const {
     printer->add_newline(2);
     auto args = "size_t num, size_t size, size_t alignment = 64";
@@ -891,6 +896,7 @@ void CodegenCoreneuronCppVisitor::print_standard_includes() {
         #include <stdlib.h>
         #include <string.h>
     )CODE");
+    print_simd_includes();
 }
 
 
@@ -2967,6 +2973,7 @@ void CodegenCoreneuronCppVisitor::print_codegen_routines() {
     print_headers_include();
     print_namespace_start();
     print_nmodl_constants();
+    print_simd_math_functions();
     print_prcellstate_macros();
     print_mechanism_info();
     print_data_structures(true);
@@ -253,6 +253,12 @@ class CodegenCoreneuronCppVisitor: public CodegenCppVisitor {
     bool optimize_ion_variable_copies() const override;
 
 
+    /**
+     * Check if functions and procedures are annotated with \c omp \c declare \c simd
+     */
+    bool simd_function_hints() const override;
+
+
     /**
      * Print memory allocation routine
      */
@@ -518,6 +518,8 @@ void CodegenCppVisitor::print_function_call(const FunctionCall& node) {
 
     if (defined_method(name)) {
         function_name = method_name(name);
+    } else if (enable_simd && codegen::naming::SIMD_FUNCTIONS_MAPPING.count(name)) {
+        function_name = codegen::naming::SIMD_FUNCTIONS_MAPPING[name];
     }
 
     if (is_nrn_pointing(name)) {
@@ -904,6 +906,111 @@ void CodegenCppVisitor::print_nmodl_constants() {
 }
 
 
+void CodegenCppVisitor::print_simd_includes() {
+    if (!enable_simd) {
+        return;
+    }
+    printer->add_line("#include <cstdint>");
+    printer->add_line("#include <cstring>");
+}
+
+
+/**
+ * \details exp(x) = 2^k exp(r) with k = round(x / ln2) and |r| <= ln2 / 2. k is
+ * rounded by adding and subtracting 1.5 * 2^52, which also leaves k in the low bits
+ * of the sum, and 2^k is built directly from the bits as two factors so that the
+ * full range down to the subnormals is covered. exp(r) is its Taylor polynomial of
+ * degree 13. Arguments beyond |x| = 746, infinities and NaN are patched in with
+ * integer bit masks rather than floating point compares, which compilers do not
+ * if-convert under the default -ftrapping-math, so the function vectorizes without
+ * a vector math library or -ffast-math. The result is within 1 ulp of \c std::exp.
+ */
+void CodegenCppVisitor::print_simd_math_functions() {
+    if (!enable_simd) {
+        return;
+    }
+    printer->add_newline(2);
+    printer->add_line("/** explicitly vectorizable math functions (codegen --simd) */");
+    printer->add_multi_line(R"CODE(
+        #pragma omp declare simd
+        static inline double nrn_simd_exp(double x) {
+            double const shift = 6755399441055744.0;
+            double const t = x * 1.4426950408889634 + shift;
+            double const k = t - shift;
+            double const r = (x - k * 6.93147180369123816490e-01) - k * 1.90821492927058770002e-10;
+            double p = 1.0 / 6227020800.0;
+            p = p * r + 1.0 / 479001600.0;
+            p = p * r + 1.0 / 39916800.0;
+            p = p * r + 1.0 / 3628800.0;
+            p = p * r + 1.0 / 362880.0;
+            p = p * r + 1.0 / 40320.0;
+            p = p * r + 1.0 / 5040.0;
+            p = p * r + 1.0 / 720.0;
+            p = p * r + 1.0 / 120.0;
+            p = p * r + 1.0 / 24.0;
+            p = p * r + 1.0 / 6.0;
+            p = p * r + 0.5;
+            p = p * r + 1.0;
+            p = p * r + 1.0;
+            std::uint64_t xbits, tbits, shiftbits;
+            std::memcpy(&xbits, &x, sizeof(x));
+            std::memcpy(&tbits, &t, sizeof(t));
+            std::memcpy(&shiftbits, &shift, sizeof(shift));
+            std::int64_t const ki = static_cast<std::int64_t>(tbits - shiftbits);
+            std::int64_t const k1 = ki >> 1;
+            std::uint64_t const s1 = (static_cast<std::uint64_t>(k1) + 1023) << 52;
+            std::uint64_t const s2 = (static_cast<std::uint64_t>(ki - k1) + 1023) << 52;
+            double f1, f2;
+            std::memcpy(&f1, &s1, sizeof(s1));
+            std::memcpy(&f2, &s2, sizeof(s2));
+            double y = p * f1 * f2;
+            std::uint64_t ybits;
+            std::memcpy(&ybits, &y, sizeof(y));
+            std::uint64_t const mag = xbits & 0x7fffffffffffffff;
+            std::uint64_t const nan = 0 - static_cast<std::uint64_t>(mag > 0x7ff0000000000000);
+            std::uint64_t const special = (xbits & nan) | (~nan & ((xbits >> 63) - 1) & 0x7ff0000000000000);
+            std::uint64_t const in_range = 0 - static_cast<std::uint64_t>(mag <= 0x4087500000000000);
+            ybits = (ybits & in_range) | (special & ~in_range);
+            std::memcpy(&y, &ybits, sizeof(y));
+            return y;
+        }
+    )CODE");
+}
+
+
+void CodegenCppVisitor::print_simd_function_hint(const ast::Block& node) {
+    if (!simd_function_hints()) {
+        return;
+    }
+    const auto params = internal_method_parameters();
+    const auto has_id = std::any_of(params.begin(), params.end(), [](const auto& param) {
+        return std::get<3>(param) == "id";
+    });
+    if (!has_id) {
+        return;
+    }
+    if (!collect_nodes(node,
+                       {ast::AstNodeType::VERBATIM,
+                        ast::AstNodeType::PROTECT_STATEMENT,
+                        ast::AstNodeType::MUTEX_LOCK,
+                        ast::AstNodeType::MUTEX_UNLOCK})
+             .empty()) {
+        return;
+    }
+    // everything but the instance index and what is loaded per instance in the
+    // kernel loop is the same for all the lanes
+    std::vector<std::string> uniform;
+    for (const auto& param: params) {
+        const auto& name = std::get<3>(param);
+        if (name != "id" && name != "v" && name != "_ppvar" && name != "ionvar") {
+            uniform.push_back(name);
+        }
+    }
+    printer->fmt_line("#pragma omp declare simd uniform({}) linear(id:1)",
+                      fmt::format("{}", fmt::join(uniform, ", ")));
+}
+
+
 /****************************************************************************************/
 /*                            Overloaded visitor routines                               */
 /****************************************************************************************/
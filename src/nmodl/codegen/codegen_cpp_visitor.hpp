@@ -278,6 +278,18 @@ class CodegenCppVisitor: public visitor::ConstAstVisitor {
         , optimize_ionvar_copies(optimize_ionvar_copies)
         , enable_cvode(enable_cvode) {}
 
+    /**
+     * Enable generation of explicitly vectorized kernels
+     *
+     * The \c nrn_state and \c nrn_cur loops are annotated with \c omp \c simd, the
+     * FUNCTIONs and PROCEDUREs they call get a \c omp \c declare \c simd variant and
+     * \c exp is replaced by a version that the compiler can vectorize without a vector
+     * math library.
+     */
+    void set_simd(bool simd) noexcept {
+        enable_simd = simd;
+    }
+
   private:
     bool enable_cvode = false;
 
@@ -325,6 +337,12 @@ class CodegenCppVisitor: public visitor::ConstAstVisitor {
     bool optimize_ionvar_copies = true;
 
 
+    /**
+     * Flag to indicate if explicitly vectorized kernels should be generated
+     */
+    bool enable_simd = false;
+
+
     /**
      * All ast information for code generation
      */
@@ -815,6 +833,11 @@ class CodegenCppVisitor: public visitor::ConstAstVisitor {
      */
     virtual bool optimize_ion_variable_copies() const = 0;
 
+    /**
+     * Check if functions and procedures are annotated with \c omp \c declare \c simd
+     */
+    virtual bool simd_function_hints() const = 0;
+
     /****************************************************************************************/
     /*                         Printing routines for code generation                        */
     /****************************************************************************************/
@@ -1447,6 +1470,38 @@ class CodegenCppVisitor: public visitor::ConstAstVisitor {
      */
     void print_nmodl_constants();
 
+
+    /**
+     * Print the headers needed by the SIMD math functions
+     */
+    void print_simd_includes();
+
+
+    /**
+     * Print the explicitly vectorizable math functions used with \c codegen \c --simd
+     *
+     * \code
+     * #pragma omp declare simd
+     * static inline double nrn_simd_exp(double x) {
+     * \endcode
+     */
+    void print_simd_math_functions();
+
+
+    /**
+     * Print the \c omp \c declare \c simd annotation of a function or procedure
+     *
+     * Everything but the instance index, the per instance \c v, \c _ppvar and
+     * \c ionvar and the user arguments is the same for all iterations of a kernel
+     * loop. Blocks with VERBATIM, PROTECT or MUTEX statements
+     * are not annotated.
+     *
+     * \code
+     * #pragma omp declare simd uniform(pnodecount, inst, data, indexes, thread, nt) linear(id:1)
+     * \endcode
+     */
+    void print_simd_function_hint(const ast::Block& node);
+
     /**
      * Print top level (global scope) verbatim blocks
      */
@@ -1566,6 +1621,7 @@ void CodegenCppVisitor::print_function_declaration(
     const T& node,
     const std::string& name,
     const std::unordered_set<CppObjectSpecifier>& specifiers) {
+    print_simd_function_hint(node);
     enable_variable_name_lookup = false;
     auto type = default_float_data_type();
 
@@ -246,6 +246,11 @@ static std::unordered_map<std::string, std::string> RANDOM_FUNCTIONS_MAPPING{
     {"random_normal", "nrnran123_normal"},
     {"random_ipick", "nrnran123_ipick"},
     {"random_dpick", "nrnran123_dblpick"}};
+
+// Math functions that are replaced by explicitly vectorizable versions when
+// code is generated with `codegen --simd`.
+static std::unordered_map<std::string, std::string> SIMD_FUNCTIONS_MAPPING{
+    {"exp", "nrn_simd_exp"}};
 // clang-format on
 }  // namespace naming
 }  // namespace codegen
@@ -87,6 +87,10 @@ bool CodegenNeuronCppVisitor::optimize_ion_variable_copies() const {
     return false;
 }
 
+bool CodegenNeuronCppVisitor::simd_function_hints() const {
+    return enable_simd && codegen_thread_variables.empty();
+}
+
 
 /****************************************************************************************/
 /*                         Printing routines for code generation                        */
@@ -565,6 +569,11 @@ void CodegenNeuronCppVisitor::add_variable_point_process(
     variables.back().is_constant = true;
 }
 
+bool CodegenNeuronCppVisitor::simd_kernel_loop() const noexcept {
+    return enable_simd && !info.point_process && !info.artificial_cell &&
+           !info.eigen_newton_solver_exist && codegen_thread_variables.empty();
+}
+
 std::string CodegenNeuronCppVisitor::internal_method_arguments() {
     const auto& args = internal_method_parameters();
     return get_arg_str(args);
@@ -1092,6 +1101,7 @@ void CodegenNeuronCppVisitor::print_standard_includes() {
         #include <stdlib.h>
         #include <vector>
     )CODE");
+    print_simd_includes();
     if (info.eigen_newton_solver_exist) {
         printer->add_multi_line(nmodl::solvers::newton_hpp);
     }
@@ -2286,6 +2296,9 @@ void CodegenNeuronCppVisitor::print_nrn_state() {
     printer->add_newline(2);
     print_global_function_common_code(BlockType::State);
 
+    if (simd_kernel_loop()) {
+        print_parallel_iteration_hint(BlockType::State, info.nrn_state_block);
+    }
     printer->push_block("for (int id = 0; id < nodecount; id++)");
     printer->add_line("int node_id = node_data.nodeindices[id];");
     printer->add_line("auto* _ppvar = _ml_arg->pdata[id];");
@@ -2499,7 +2512,9 @@ void CodegenNeuronCppVisitor::print_nrn_cur() {
     printer->add_newline(2);
     printer->add_line("/** update current */");
     print_global_function_common_code(BlockType::Equation);
-    // print_channel_iteration_block_parallel_hint(BlockType::Equation, info.breakpoint_node);
+    if (simd_kernel_loop()) {
+        print_parallel_iteration_hint(BlockType::Equation, info.breakpoint_node);
+    }
     printer->push_block("for (int id = 0; id < nodecount; id++)");
     print_nrn_cur_kernel(*info.breakpoint_node);
     // print_nrn_cur_matrix_shadow_update();
@@ -2670,6 +2685,7 @@ void CodegenNeuronCppVisitor::print_codegen_routines_regular() {
     print_neuron_global_variable_declarations();
     print_namespace_start();
     print_nmodl_constants();
+    print_simd_math_functions();
     print_prcellstate_macros();
     print_mechanism_info();
     print_data_structures(true);
@@ -2699,6 +2715,7 @@ void CodegenNeuronCppVisitor::print_codegen_routines_nothing() {
     print_backend_info();
     print_headers_include();
     print_namespace_start();
+    print_simd_math_functions();
     print_function_prototypes();
     print_top_verbatim_blocks();
     print_global_variables_for_hoc();
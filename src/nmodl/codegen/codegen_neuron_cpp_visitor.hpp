@@ -158,6 +158,14 @@ class CodegenNeuronCppVisitor: public CodegenCppVisitor {
      */
     bool optimize_ion_variable_copies() const override;
 
+    /**
+     * Check if functions and procedures are annotated with \c omp \c declare \c simd
+     *
+     * As for the kernel loops, not with THREADSAFE assigned GLOBALs, see
+     * simd_kernel_loop.
+     */
+    bool simd_function_hints() const override;
+
     /****************************************************************************************/
     /*                         Printing routines for code generation                        */
     /****************************************************************************************/
@@ -305,6 +313,17 @@ class CodegenNeuronCppVisitor: public CodegenCppVisitor {
     void add_variable_tqitem(std::vector<IndexVariableInfo>& variables) override;
     void add_variable_point_process(std::vector<IndexVariableInfo>& variables) override;
 
+
+    /**
+     * Check if the nrn_state and nrn_cur loops are annotated for SIMD execution
+     *
+     * Only with \c codegen \c --simd and only for density mechanisms without Newton
+     * solvers: instances of a point process can share a node and so the same \c rhs
+     * and ion entries. Nor with THREADSAFE assigned GLOBALs, which are a single
+     * value per thread that all the lanes would write.
+     */
+    bool simd_kernel_loop() const noexcept;
+
     /**
      * Arguments for functions that are defined and used internally.
      * \return the method arguments
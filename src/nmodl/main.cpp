@@ -120,6 +120,9 @@ int run_nmodl(int argc, const char* argv[]) {
     /// true if CVODE should be emitted
     bool codegen_cvode(false);
 
+    /// true if explicitly vectorized kernels should be emitted
+    bool codegen_simd(false);
+
     /// true if localize variables even if verbatim block is used
     bool localize_verbatim(false);
 
@@ -288,6 +291,9 @@ int run_nmodl(int argc, const char* argv[]) {
     codegen_opt->add_flag("--cvode",
         codegen_cvode,
         fmt::format("Print code for CVODE ({})", codegen_cvode))->ignore_case();
+    codegen_opt->add_flag("--simd",
+        codegen_simd,
+        fmt::format("Emit explicitly vectorized nrn_state/nrn_cur kernels ({})", codegen_simd))->ignore_case();
 
 #if NRN_USE_BACKWARD
     auto blame_opt = app.add_subcommand("blame", "Blame NMODL code that generated some code.");
@@ -628,6 +634,7 @@ int run_nmodl(int argc, const char* argv[]) {
                                                     data_type,
                                                     optimize_ionvar_copies_codegen,
                                                     utils::make_blame(blame_line, blame_level));
+                visitor.set_simd(codegen_simd);
                 visitor.visit_program(*ast);
             }
 
@@ -639,6 +646,7 @@ int run_nmodl(int argc, const char* argv[]) {
                                                 optimize_ionvar_copies_codegen,
                                                 codegen_cvode,
                                                 utils::make_blame(blame_line, blame_level));
+                visitor.set_simd(codegen_simd);
                 visitor.visit_program(*ast);
             }
 
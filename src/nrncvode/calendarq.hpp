@@ -0,0 +1,291 @@
+/*
+** calendarq.hpp: Calendar queue event-set with the same interface as SPTree.
+**
+** Items are hashed by time into a ring of buckets ("days") of fixed width.
+** Each bucket is a contiguous array of (time, item) entries that is appended
+** to in insertion order and stably sorted only when the bucket is reached by
+** dequeue, so items of equal time are dequeued in insertion order and the
+** sequence of dequeued items is identical to that of the splay tree.
+** Enqueue and dequeue are O(1) amortized when the bucket width matches the
+** spacing of pending events; the number of buckets and the width are
+** re-estimated whenever the number of items grows or shrinks by a factor
+** of two.
+**
+** Based on
+**     Calendar Queues: A Fast O(1) Priority Queue Implementation for the
+**     Simulation Event Set Problem, R. Brown, Comm. ACM 31(10) (1988) 1220-1227.
+**
+** T must have a `double t_` member, the key, which must not be changed while
+** the item is in the queue.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+template <typename T>
+class CalendarQ {
+  public:
+    CalendarQ() {
+        buckets_.resize(min_nbucket);
+    }
+
+    // Is this CalendarQ empty?
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    // Number of items.
+    std::size_t size() const {
+        return size_;
+    }
+
+    // Number of times the bucket array was rebuilt.
+    int get_nresize() const {
+        return nresize_;
+    }
+
+    // Insert item, after all other items with the same key.
+    void enqueue(T* n);
+
+    // Return and remove the first item.
+    T* dequeue();
+
+    // Return the item with the lowest key.
+    T* first();
+
+    // Remove item `n` from the queue.
+    void remove(T* n);
+
+    // Find an item with the given key.
+    T* find(double key);
+
+    // Apply the function `f` to each item, not in ascending order. The
+    // integer argument is always `0`.
+    void apply_all(void (*f)(const T*, int), T*) const;
+
+  private:
+    struct Entry {
+        double t;
+        T* item;
+    };
+    struct Bucket {
+        std::vector<Entry> entries;  // entries[0, head) already dequeued
+        std::size_t head{};
+        bool sorted{true};  // entries[head, end) ascending
+        bool empty() const {
+            return head == entries.size();
+        }
+        const Entry& front() {
+            if (!sorted) {
+                // stable, so equal times stay in insertion order
+                std::stable_sort(entries.begin() + head,
+                                 entries.end(),
+                                 [](const Entry& a, const Entry& b) { return a.t < b.t; });
+                sorted = true;
+            }
+            return entries[head];
+        }
+        void clear() {
+            entries.clear();
+            head = 0;
+            sorted = true;
+        }
+    };
+    static constexpr std::size_t min_nbucket = 16;
+
+    double day(double key) const {
+        // keep far future times, e.g. 1e15 sentinels, in integer range
+        return std::clamp(std::floor(key / width_), -1e18, 1e18);
+    }
+    Bucket& bucket(double d) {
+        return buckets_[static_cast<std::uint64_t>(static_cast<std::int64_t>(d)) &
+                        (buckets_.size() - 1)];
+    }
+    // Set cur_ and cur_day_ to the bucket and day of the first item.
+    bool locate_first();
+    void resize(std::size_t nbucket);
+
+    std::vector<Bucket> buckets_;
+    std::size_t size_{};
+    double width_{0.1};
+    double cur_day_{};  // no item has an earlier day
+    Bucket* cur_{};     // bucket of cur_day_ after locate_first
+    int nresize_{};
+};
+
+template <typename T>
+void CalendarQ<T>::enqueue(T* n) {
+    if (size_ + 1 > 2 * buckets_.size()) {
+        resize(2 * buckets_.size());
+    }
+    double const t = n->t_;
+    double const d = day(t);
+    if (size_ == 0 || d < cur_day_) {
+        cur_day_ = d;
+        cur_ = nullptr;
+    }
+    Bucket& b = bucket(d);
+    auto& e = b.entries;
+    if (!b.sorted || b.empty() || !(t < e.back().t)) {
+        b.sorted = b.sorted && (b.empty() || !(t < e.back().t));
+        e.push_back({t, n});
+    } else {
+        // Sorted because dequeue reached it. Keep it so.
+        auto it = std::upper_bound(e.begin() + b.head, e.end(), t, [](double t, const Entry& q) {
+            return t < q.t;
+        });
+        if (it == e.begin() + b.head && b.head > 0) {
+            // reuse a dequeued slot instead of shifting
+            e[--b.head] = {t, n};
+        } else {
+            e.insert(it, {t, n});
+        }
+    }
+    ++size_;
+}
+
+template <typename T>
+bool CalendarQ<T>::locate_first() {
+    if (size_ == 0) {
+        return false;
+    }
+    if (cur_ && !cur_->empty() && day(cur_->front().t) == cur_day_) {
+        return true;
+    }
+    // one year of days starting at cur_day_
+    for (std::size_t i = 0; i < buckets_.size(); ++i, cur_day_ += 1.0) {
+        Bucket& b = bucket(cur_day_);
+        if (!b.empty() && day(b.front().t) <= cur_day_) {
+            cur_ = &b;
+            cur_day_ = day(b.front().t);
+            return true;
+        }
+    }
+    // sparse, far in the future. Jump directly to the least bucket front.
+    Bucket* least = nullptr;
+    for (auto& b: buckets_) {
+        if (!b.empty() && (!least || b.front().t < least->front().t)) {
+            least = &b;
+        }
+    }
+    cur_ = least;
+    cur_day_ = day(least->front().t);
+    return true;
+}
+
+template <typename T>
+T* CalendarQ<T>::first() {
+    return locate_first() ? cur_->front().item : nullptr;
+}
+
+template <typename T>
+T* CalendarQ<T>::dequeue() {
+    if (!locate_first()) {
+        return nullptr;
+    }
+    Bucket& b = *cur_;
+    T* n = b.entries[b.head++].item;
+    if (b.empty()) {
+        b.clear();
+    }
+    --size_;
+    if (buckets_.size() > min_nbucket && 2 * size_ < buckets_.size()) {
+        resize(buckets_.size() / 2);
+    }
+    return n;
+}
+
+template <typename T>
+void CalendarQ<T>::remove(T* n) {
+    Bucket& b = bucket(day(n->t_));
+    auto& e = b.entries;
+    auto it = std::find_if(e.begin() + b.head, e.end(), [n](const Entry& q) {
+        return q.item == n;
+    });
+    if (it == e.end()) {
+        return;
+    }
+    e.erase(it);
+    if (b.empty()) {
+        b.clear();
+    }
+    --size_;
+}
+
+template <typename T>
+T* CalendarQ<T>::find(double key) {
+    Bucket& b = bucket(day(key));
+    auto& e = b.entries;
+    auto it = std::find_if(e.begin() + b.head, e.end(), [key](const Entry& q) {
+        return q.t == key;
+    });
+    return it != e.end() ? it->item : nullptr;
+}
+
+template <typename T>
+void CalendarQ<T>::apply_all(void (*f)(const T*, int), T*) const {
+    for (auto& b: buckets_) {
+        for (std::size_t i = b.head; i < b.entries.size(); ++i) {
+            f(b.entries[i].item, 0);
+        }
+    }
+}
+
+template <typename T>
+void CalendarQ<T>::resize(std::size_t nbucket) {
+    ++nresize_;
+    std::vector<Entry> all;
+    all.reserve(size_);
+    for (auto& b: buckets_) {
+        all.insert(all.end(), b.entries.begin() + b.head, b.entries.end());
+    }
+    // Bucket width about three times the mean spacing of the earlier half of
+    // the items, so that distant outliers do not inflate it. But with the
+    // fixed step method many items share a time and a bucket narrower than
+    // the spacing of distinct times is mostly empty, so not less than the
+    // smallest distinct spacing seen in a sample.
+    if (all.size() > 1) {
+        std::vector<double> sample;
+        std::size_t stride = std::max<std::size_t>(1, all.size() / 1024);
+        for (std::size_t i = 0; i < all.size(); i += stride) {
+            sample.push_back(all[i].t);
+        }
+        auto mid = sample.begin() + sample.size() / 2;
+        std::nth_element(sample.begin(), mid, sample.end());
+        std::sort(sample.begin(), mid + 1);
+        double const span = *mid - sample.front();
+        double w = 3.0 * span / (all.size() / 2);
+        double mingap = span;
+        for (auto it = sample.begin() + 1; it <= mid; ++it) {
+            double const gap = *it - *(it - 1);
+            if (gap > 1e-6 * span) {
+                mingap = std::min(mingap, gap);
+            }
+        }
+        w = std::max(w, mingap);
+        if (w > 0.0) {
+            width_ = w;
+        }
+    }
+    buckets_.clear();
+    buckets_.resize(nbucket);
+    cur_ = nullptr;
+    // Equal keys always shared a bucket, so appending each old bucket in
+    // order keeps them in insertion order.
+    size_ = 0;
+    for (const Entry& q: all) {
+        double const d = day(q.t);
+        if (size_ == 0 || d < cur_day_) {
+            cur_day_ = d;
+        }
+        Bucket& b = bucket(d);
+        b.sorted = b.sorted && (b.empty() || !(q.t < b.entries.back().t));
+        b.entries.push_back(q);
+        ++size_;
+    }
+}
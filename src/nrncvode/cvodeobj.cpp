@@ -130,7 +130,10 @@ static double queue_mode(void* v) {
         }
 #endif
     }
-    return double(nrn_use_bin_queue_ + 2 * nrn_use_selfqueue_);
+    if (ifarg(3)) {
+        nrn_use_calendar_queue_ = chkarg(3, 0, 1) ? true : false;
+    }
+    return double(nrn_use_bin_queue_ + 2 * nrn_use_selfqueue_ + 4 * nrn_use_calendar_queue_);
     return 0.;
 }
 
@@ -560,6 +563,14 @@ static double use_fast_imem(void* v) {
     return i;
 }
 
+static double nvector_serial_length(void*) {
+    if (ifarg(1)) {
+        N_VSerialLength_NrnThread(long(chkarg(1, 0., 1e15)));
+    }
+    hoc_return_type_code = 1;  // integer
+    return double(N_VSerialLength_NrnThread(-1));
+}
+
 static double poolshrink(void*) {
     extern void nrn_poolshrink(int);
     int i = 0;
@@ -623,6 +634,7 @@ static Member_func members[] = {{"solve", solve},
                                 {"extra_scatter_gather", extra_scatter_gather},
                                 {"extra_scatter_gather_remove", extra_scatter_gather_remove},
                                 {"use_fast_imem", use_fast_imem},
+                                {"nvector_serial_length", nvector_serial_length},
                                 {"poolshrink", poolshrink},
                                 {"free_event_queues", free_event_queues},
                                 {nullptr, nullptr}};
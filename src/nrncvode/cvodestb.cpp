@@ -91,6 +91,13 @@ void fixed_record_continuous(neuron::model_sorted_token const& cache_token, NrnT
     }
 }
 
+// after a join of the threads, see ColumnRecord
+void nrn_record_commit() {
+    if (net_cvode_instance) {
+        net_cvode_instance->record_commit();
+    }
+}
+
 void nrn_solver_prepare() {
     if (net_cvode_instance) {
         net_cvode_instance->solver_prepare();
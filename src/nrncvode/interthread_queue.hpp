@@ -0,0 +1,100 @@
+#pragma once
+
+// Lock free delivery of events from one NrnThread to another.
+//
+// Each target NetCvodeThreadData owns one InterThreadQueue per source
+// thread. A queue has exactly one producer (the worker executing the source
+// thread) and one consumer (the worker executing the target thread), so
+// neither side needs a mutex. Storage is a linked list of fixed size chunks.
+// The producer appends to the tail chunk and publishes each item with a
+// release store of the chunk count. The consumer drains from the head chunk
+// and hands a fully consumed chunk back to the producer through a one slot
+// spare so that steady state traffic does not allocate.
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+class DiscreteEvent;
+
+struct InterThreadEvent {
+    DiscreteEvent* de_;
+    double t_;
+};
+
+class InterThreadQueue {
+  public:
+    InterThreadQueue() {
+        head_ = tail_ = new Chunk();
+    }
+    ~InterThreadQueue() {
+        for (Chunk* c = head_; c;) {
+            delete std::exchange(c, c->next_.load(std::memory_order_relaxed));
+        }
+        delete spare_.load(std::memory_order_relaxed);
+    }
+    InterThreadQueue(const InterThreadQueue&) = delete;
+    InterThreadQueue& operator=(const InterThreadQueue&) = delete;
+
+    // producer side
+    void push(DiscreteEvent* de, double t) {
+        std::size_t n = tail_->count_.load(std::memory_order_relaxed);
+        if (n == chunk_size) {
+            Chunk* c = spare_.exchange(nullptr, std::memory_order_acquire);
+            if (c) {
+                c->count_.store(0, std::memory_order_relaxed);
+                c->next_.store(nullptr, std::memory_order_relaxed);
+            } else {
+                c = new Chunk();
+            }
+            tail_->next_.store(c, std::memory_order_release);
+            tail_ = c;
+            n = 0;
+        }
+        InterThreadEvent& ite = tail_->items_[n];
+        ite.de_ = de;
+        ite.t_ = t;
+        tail_->count_.store(n + 1, std::memory_order_release);
+    }
+
+    // consumer side. Calls f(InterThreadEvent&) for every published item.
+    template <typename F>
+    void drain(F&& f) {
+        for (;;) {
+            std::size_t n = head_->count_.load(std::memory_order_acquire);
+            while (head_index_ < n) {
+                f(head_->items_[head_index_++]);
+            }
+            if (head_index_ < chunk_size) {
+                return;
+            }
+            Chunk* next = head_->next_.load(std::memory_order_acquire);
+            if (!next) {
+                return;
+            }
+            // The producer has moved on to next and never touches head_ again.
+            delete spare_.exchange(head_, std::memory_order_release);
+            head_ = next;
+            head_index_ = 0;
+        }
+    }
+
+    // consumer side. Discard everything published so far.
+    void clear() {
+        drain([](InterThreadEvent&) {});
+    }
+
+  private:
+    static constexpr std::size_t chunk_size = 256;
+    struct Chunk {
+        InterThreadEvent items_[chunk_size];
+        std::atomic<std::size_t> count_{0};
+        std::atomic<Chunk*> next_{nullptr};
+    };
+    // Keep producer and consumer state on separate cache lines.
+    alignas(64) Chunk* tail_;
+    alignas(64) Chunk* head_;
+    std::size_t head_index_{0};
+    alignas(64) std::atomic<Chunk*> spare_{nullptr};
+};
@@ -16,6 +16,7 @@
 #include "datapath.h"
 #include "objcmd.h"
 #include "kssingle.h"
+#include "lfp.h"
 #include "ocnotify.h"
 #include "utils/enumerate.h"
 #if HAVE_IV
@@ -29,6 +30,7 @@
 #include "ivocvect.h"
 #include "netcon.h"
 #include "netcvode.h"
+#include "interthread_queue.hpp"
 #include "nrn_ansi.h"
 #include "nrncore_write/utils/nrncore_utils.h"
 #include "nrniv_mf.h"
@@ -37,6 +39,7 @@
 #include "utils/profile/profiler_interface.h"
 #include "utils/formatting.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cerrno>
 #include <cstdlib>
@@ -76,6 +79,7 @@ int nrn_use_selfqueue_;
 void nrn_pending_selfqueue(double tt, NrnThread*);
 static void all_pending_selfqueue(double tt);
 static void* pending_selfqueue(NrnThread*);
+static void* reserve_event_pools(NrnThread*);
 extern int nrn_use_daspk_;
 int linmod_extra_eqn_count();
 extern int nrn_modeltype();
@@ -217,6 +221,8 @@ extern void nrn2ncs_outputevent(int netcon_output_index, double firetime);
 #if NRNMPI
 extern void nrn_multisend_send(PreSyn*, double t);
 extern bool use_multisend_;
+extern bool use_overlap_exchange_;
+extern void nrn_spike_exchange_advance();
 extern void nrn_multisend_advance();
 #endif
 
@@ -397,13 +403,8 @@ class MaxStateItem {
     double amax_;
 };
 
-struct InterThreadEvent {
-    DiscreteEvent* de_;
-    double t_;
-};
-
 typedef std::vector<WatchCondition*> WatchList;
-using SelfEventPool = MutexPool<SelfEvent>;
+using SelfEventPool = LocalPool<SelfEvent>;
 typedef std::vector<TQItem*> TQList;
 
 // allows marshalling of all items in the event queue that need to be
@@ -984,27 +985,24 @@ Object** NetCvode::netconlist() {
     return po;
 }
 
-#define ITE_SIZE 10
 NetCvodeThreadData::NetCvodeThreadData() {
-    tpool_ = new TQItemPool(1000, 1);
+    // owner set by NetCvode::p_construct
+    tpool_ = new TQItemPool(1000);
     // tqe_ accessed only by thread i so no locking
     tqe_ = new TQueue(tpool_, 0);
-    sepool_ = new SelfEventPool(1000, 1);
+    sepool_ = new SelfEventPool(1000);
     selfqueue_ = nullptr;
     psl_thr_ = nullptr;
     tq_ = nullptr;
     lcv_ = nullptr;
-    ite_size_ = ITE_SIZE;
-    ite_cnt_ = 0;
     unreffed_event_cnt_ = 0;
     immediate_deliver_ = -1e100;
-    inter_thread_events_ = new InterThreadEvent[ite_size_];
+    n_inter_thread_queues_ = std::max(nrn_nthread, 1);
+    inter_thread_queues_ = std::make_unique<InterThreadQueue[]>(n_inter_thread_queues_);
     nlcv_ = 0;
-    MUTCONSTRUCT(1)
 }
 
 NetCvodeThreadData::~NetCvodeThreadData() {
-    delete[] std::exchange(inter_thread_events_, nullptr);
     if (psl_thr_) {
         hoc_l_freelist(&psl_thr_);
     }
@@ -1022,12 +1020,12 @@ NetCvodeThreadData::~NetCvodeThreadData() {
         }
         delete[] std::exchange(lcv_, nullptr);
     }
-    MUTDESTRUCT
 }
 
+// Called while executing the source thread. The event goes into the target's
+// queue for that source, which no other system thread pushes to concurrently.
 void NetCvodeThreadData::interthread_send(double td, DiscreteEvent* db, NrnThread* nt) {
     // bin_event(td, db, nt);
-    MUTLOCK
 #if PRINT_EVENT
     if (net_cvode_instance->print_event_) {
         Printf("interthread send td=%.15g DE type=%d thread=%d target=%d %s\n",
@@ -1038,34 +1036,18 @@ void NetCvodeThreadData::interthread_send(double td, DiscreteEvent* db, NrnThrea
                (db->type() == 2) ? hoc_object_name(((NetCon*) (db))->target_->ob) : "?");
     }
 #endif
-    if (ite_cnt_ >= ite_size_) {
-        ite_size_ *= 2;
-        InterThreadEvent* in = new InterThreadEvent[ite_size_];
-        for (int i = 0; i < ite_cnt_; ++i) {
-            in[i].de_ = inter_thread_events_[i].de_;
-            in[i].t_ = inter_thread_events_[i].t_;
-        }
-        delete[] std::exchange(inter_thread_events_, in);
-    }
-    InterThreadEvent& ite = inter_thread_events_[ite_cnt_++];
-    ite.de_ = db;
-    ite.t_ = td;
-    // race since each NetCvodeThreadData has its own lock and enqueueing_
-    // is a NetCvode instance variable. enqueuing_ is not logically
-    // needed but can avoid a nrn_multithread_job call in allthread_least_t
-    // which does nothing if there are no interthread events.
-    // int& b = net_cvode_instance->enqueueing_;
-    // if (!b) { b = 1; }
-    MUTUNLOCK
-    // have decided to lock net_cvode_instance and set it
+    int src = nrn_executing_thread_id();
+    assert(src < n_inter_thread_queues_);
+    inter_thread_queues_[src].push(db, td);
+    // enqueuing_ is not logically needed but can avoid a nrn_multithread_job
+    // call in allthread_least_t which does nothing if there are no
+    // interthread events.
     net_cvode_instance->set_enqueueing();
 }
 
+// Called by the worker executing the target thread.
 void NetCvodeThreadData::enqueue(NetCvode* nc, NrnThread* nt) {
-    int i;
-    MUTLOCK
-    for (i = 0; i < ite_cnt_; ++i) {
-        InterThreadEvent& ite = inter_thread_events_[i];
+    auto deliver = [nc, nt](InterThreadEvent& ite) {
 #if PRINT_EVENT
         if (net_cvode_instance->print_event_) {
             Printf("interthread enqueue td=%.15g DE type=%d thread=%d target=%d %s\n",
@@ -1078,9 +1060,10 @@ void NetCvodeThreadData::enqueue(NetCvode* nc, NrnThread* nt) {
         }
 #endif
         nc->bin_event(ite.t_, ite.de_, nt);
+    };
+    for (int i = 0; i < n_inter_thread_queues_; ++i) {
+        inter_thread_queues_[i].drain(deliver);
     }
-    ite_cnt_ = 0;
-    MUTUNLOCK
 }
 
 NetCvode::NetCvode(bool single) {
@@ -2520,7 +2503,12 @@ void NetCvode::hoc_event(double tt, const char* stmt, Object* ppobj, int reinit,
             if (ppobj) {
                 int i = PP2NT(ob2pntproc(ppobj))->id;
                 p[i].interthread_send(tt, HocEvent::alloc(stmt, ppobj, reinit, pyact), nt + i);
-                nrn_interthread_enqueue(nt + i);
+                // Within a thread job the worker of thread i may be draining
+                // its queues, so leave the event for it to enqueue at its
+                // next deliver_events or allthread_least_t.
+                if (!nrn_inthread_) {
+                    nrn_interthread_enqueue(nt + i);
+                }
             } else {
                 HocEvent* he = HocEvent::alloc(stmt, nullptr, 0, pyact);
                 // put on each queue. The first thread to execute the deliver
@@ -2680,7 +2668,9 @@ void NetCvode::clear_events() {
             d.sepool_->free_all();
         }
         d.immediate_deliver_ = -1e100;
-        d.ite_cnt_ = 0;
+        for (int j = 0; j < d.n_inter_thread_queues_; ++j) {
+            d.inter_thread_queues_[j].clear();
+        }
         if (nrn_use_selfqueue_) {
             if (!d.selfqueue_) {
                 d.selfqueue_ = new SelfQueue(d.tpool_, 0);
@@ -2690,6 +2680,15 @@ void NetCvode::clear_events() {
         }
         d.tqe_->nshift_ = -1;
         d.tqe_->shift_bin(nt_t - 0.5 * nt_dt);
+        if (d.tpool_) {
+            d.tpool_->clear_counters();
+        }
+        if (d.sepool_) {
+            d.sepool_->clear_counters();
+        }
+    }
+    if (nrn_nthread > 1) {
+        nrn_multithread_job(reserve_event_pools);
     }
     // I don't believe this is needed anymore since cvode not needed
     // til delivery.
@@ -3718,6 +3717,18 @@ TQueue* NetCvode::event_queue(NrnThread* nt) {
     return p[nt->id].tqe_;
 }
 
+// so the first chunk of the pools is first touched by the worker of nt
+static void* reserve_event_pools(NrnThread* nt) {
+    NetCvodeThreadData& d = net_cvode_instance->p[nt->id];
+    if (d.tpool_) {
+        d.tpool_->reserve();
+    }
+    if (d.sepool_) {
+        d.sepool_->reserve();
+    }
+    return nullptr;
+}
+
 static double pending_selfqueue_deliver_;
 static void* pending_selfqueue(NrnThread* nt) {
     nrn_pending_selfqueue(pending_selfqueue_deliver_, nt);
@@ -3857,6 +3868,23 @@ void NetCvode::statistics(int i) {
            DiscreteEvent::discretevent_send_,
            DiscreteEvent::discretevent_deliver_);
     Printf("%lu total events delivered  net_event=%lu\n", deliver_cnt_, net_event_cnt_);
+    for (int it = 0; it < pcnt_; ++it) {
+        NetCvodeThreadData& d = p[it];
+        if (d.tpool_ && d.sepool_) {
+            Printf(
+                "Thread %d pools: TQItem alloc=%lu remote free=%lu max used=%ld size=%ld  "
+                "SelfEvent alloc=%lu remote free=%lu max used=%ld size=%ld\n",
+                it,
+                d.tpool_->nalloc(),
+                d.tpool_->nremote_free(),
+                d.tpool_->maxget(),
+                d.tpool_->size(),
+                d.sepool_->nalloc(),
+                d.sepool_->nremote_free(),
+                d.sepool_->maxget(),
+                d.sepool_->size());
+        }
+    }
     Printf("Discrete event TQueue\n");
     p[0].tqe_->statistics();
     if (p[0].tq_) {
@@ -4102,6 +4130,21 @@ void NetCvode::record_init() {
     for (auto& item: *prl_) {
         item->record_init();
     }
+    for (auto* cr: column_record_) {
+        cr->record_init();
+    }
+    for (auto* lfp: lfp_) {
+        lfp->record_init();
+    }
+}
+
+void NetCvode::record_commit() {
+    for (auto* cr: column_record_) {
+        cr->commit();
+    }
+    for (auto* lfp: lfp_) {
+        lfp->commit();
+    }
 }
 
 void NetCvode::play_init() {
@@ -4888,6 +4931,12 @@ void NetCvode::p_construct(int n) {
     }
     for (i = 0; i < n; ++i) {
         p[i].unreffed_event_cnt_ = 0;
+        if (p[i].tpool_) {
+            p[i].tpool_->set_owner(i);
+        }
+        if (p[i].sepool_) {
+            p[i].sepool_->set_owner(i);
+        }
     }
 }
 
@@ -5497,6 +5546,12 @@ void NetCvode::fixed_record_continuous(neuron::model_sorted_token const& cache_t
             pr->continuous(nt._t);
         }
     }
+    for (auto* cr: column_record_) {
+        cr->continuous(nt);
+    }
+    for (auto* lfp: lfp_) {
+        lfp->continuous(nt);
+    }
 }
 
 void NetCvode::fixed_play_continuous(NrnThread* nt) {
@@ -5927,6 +5982,8 @@ void NetCvode::deliver_net_events(NrnThread* nt) {  // for default method
 #if NRNMPI
     if (use_multisend_) {
         nrn_multisend_advance();
+    } else if (use_overlap_exchange_ && nt->id == 0) {
+        nrn_spike_exchange_advance();
     }
 #endif
     int tid = nt->id;
@@ -6764,9 +6821,10 @@ void* nrn_interthread_enqueue(NrnThread* nt) {
 }
 
 void NetCvode::set_enqueueing() {
-    MUTLOCK
-    enqueueing_ = 1;
-    MUTUNLOCK
+    // check first to avoid bouncing the cache line on every send
+    if (!enqueueing_.load(std::memory_order_relaxed)) {
+        enqueueing_.store(1, std::memory_order_relaxed);
+    }
 }
 
 double NetCvode::allthread_least_t(int& tid) {
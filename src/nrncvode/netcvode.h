@@ -8,7 +8,9 @@
 #include "neuron/container/data_handle.hpp"
 #include "tqueue.hpp"
 
+#include <atomic>
 #include <cmath>
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
@@ -19,9 +21,11 @@ using PreSynTable = std::unordered_map<neuron::container::data_handle<double>, P
 class NetCon;
 class DiscreteEvent;
 class SelfEvent;
-using SelfEventPool = MutexPool<SelfEvent>;
+using SelfEventPool = LocalPool<SelfEvent>;
 struct hoc_Item;
 class PlayRecord;
+class ColumnRecord;
+class LFP;
 class IvocVect;
 struct BAMechList;
 // nrn_nthread vectors of HTList* for fixed step method
@@ -37,7 +41,7 @@ class HocEvent;
 typedef std::vector<HocEvent*> HocEventList;
 struct BAMech;
 struct Section;
-struct InterThreadEvent;
+class InterThreadQueue;
 
 class NetCvodeThreadData {
   public:
@@ -51,12 +55,12 @@ class NetCvodeThreadData {
     hoc_Item* psl_thr_;  // for presyns with fixed step threshold checking
     SelfEventPool* sepool_;
     TQItemPool* tpool_;
-    InterThreadEvent* inter_thread_events_;
+    // one per source thread, see interthread_queue.hpp
+    std::unique_ptr<InterThreadQueue[]> inter_thread_queues_;
+    int n_inter_thread_queues_;
     SelfQueue* selfqueue_;
     MUTDEC
     int nlcv_;
-    int ite_cnt_;
-    int ite_size_;
     int unreffed_event_cnt_;
     double immediate_deliver_;
 };
@@ -127,6 +131,11 @@ class NetCvode {
     // fixed step continuous play and record
     std::vector<PlayRecord*>* fixed_play_;
     std::vector<PlayRecord*>* fixed_record_;
+    // PtrVector.record
+    std::vector<ColumnRecord*> column_record_;
+    // LFP.record
+    std::vector<LFP*> lfp_;
+    void record_commit();
     void vecrecord_add();  // hoc interface functions
     void vec_remove();
     void record_init();
@@ -246,11 +255,11 @@ class NetCvode {
     HTListList wl_list_;  // nrn_nthread of these for faster deliver_net_events when many cvode
     int pcnt_;
     NetCvodeThreadData* p;
-    int enqueueing_;
+    std::atomic<int> enqueueing_;
     int use_long_double_;
 
   public:
-    MUTDEC  // only for enqueueing_ so far.
+    MUTDEC
     void set_enqueueing();
     double allthread_least_t(int& tid);
     int solve_when_threads(double);
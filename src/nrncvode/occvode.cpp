@@ -9,10 +9,12 @@
 #include "cvodeobj.h"
 #include "netcvode.h"
 #include "ivocvect.h"
+#include "lfp.h"
 #include "vrecitem.h"
 #include "membfunc.h"
 #include "nonvintblock.h"
 #include "nrndigest.h"
+#include "nrncvode.h"
 
 #include <cerrno>
 #include <numeric>
@@ -20,6 +22,7 @@
 
 #include "spmatrix.h"
 extern double* sp13mat;
+extern NetCvode* net_cvode_instance;
 
 #if 1 || NRNMPI
 extern void (*nrnthread_v_transfer_)(NrnThread*);
@@ -1072,6 +1075,13 @@ void Cvode::record_continuous() {
                 }
             }
         }
+        for (auto* cr: net_cvode_instance->column_record_) {
+            cr->continuous();
+        }
+        for (auto* lfp: net_cvode_instance->lfp_) {
+            lfp->continuous();
+        }
+        nrn_record_commit();
     }
 }
 
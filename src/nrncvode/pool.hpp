@@ -10,9 +10,15 @@
 // the pool doubles in size every time a chain Pool is added.
 // maxget() tells the most number of pool items used at once.
 
+#include "multicore.h"
 #include <nrnmutdec.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 template <typename T>
 class MutexPool {
@@ -129,3 +135,143 @@ void MutexPool<T>::free_all() {
     put_ = 0;
     MUTUNLOCK
 }
+
+// Pool owned by one NrnThread, for the TQItem and SelfEvent of its event
+// queue. alloc and hpfree do not lock. hpfree from a job executing another
+// NrnThread appends to a mutex protected deferred list that the owner takes
+// over when its free list is empty. alloc must not run concurrently with the
+// owner, e.g. from another NrnThread only while the owner is done with the
+// current job, as for spike exchange.
+// Chunks are allocated (and constructed, i.e. first touched) by the thread
+// that calls alloc or reserve so, with the default first-touch NUMA policy,
+// the items are in memory local to the worker of the owner. Each new chunk
+// doubles the number of items.
+
+template <typename T>
+class LocalPool {
+  public:
+    explicit LocalPool(long count, int owner = 0)
+        : count_{count}
+        , owner_{owner} {}
+    T* alloc();
+    void hpfree(T*);
+    // allocate the first chunk, if not done already, from the calling thread
+    void reserve() {
+        if (chunks_.empty()) {
+            grow();
+        }
+    }
+    void free_all();
+    void set_owner(int owner) {
+        owner_ = owner;
+    }
+    long maxget() const {
+        return maxget_;
+    }
+    long size() const {
+        return size_;
+    }
+    unsigned long nalloc() const {
+        return nalloc_;
+    }
+    unsigned long nremote_free() const {
+        return nremote_free_;
+    }
+    void clear_counters() {
+        nalloc_ = nremote_free_ = 0;
+        maxget_ = nget_;
+    }
+
+  private:
+    bool owner_calling() const {
+        return !nrn_inthread_ || nrn_executing_thread_id() == owner_;
+    }
+    void take_deferred();
+    void grow();
+    std::vector<std::unique_ptr<T[]>> chunks_;
+    std::vector<long> chunk_sizes_;
+    std::vector<T*> free_;
+    long count_;  // size of the first chunk
+    long size_{};
+    long nget_{};
+    long maxget_{};
+    unsigned long nalloc_{};
+    int owner_;
+    // from other NrnThread
+    std::atomic<bool> has_deferred_{false};
+    std::mutex deferred_mut_;
+    std::vector<T*> deferred_;
+    unsigned long nremote_free_{};  // under deferred_mut_
+};
+
+template <typename T>
+void LocalPool<T>::grow() {
+    long n = chunks_.empty() ? count_ : size_;
+    chunks_.emplace_back(new T[n]);
+    chunk_sizes_.push_back(n);
+    size_ += n;
+    T* chunk = chunks_.back().get();
+    free_.reserve(size_);
+    // hand out in address order
+    for (long i = n - 1; i >= 0; --i) {
+        free_.push_back(chunk + i);
+    }
+}
+
+template <typename T>
+void LocalPool<T>::take_deferred() {
+    std::lock_guard<std::mutex> lock{deferred_mut_};
+    free_.insert(free_.end(), deferred_.begin(), deferred_.end());
+    nget_ -= long(deferred_.size());
+    deferred_.clear();
+    has_deferred_.store(false, std::memory_order_relaxed);
+}
+
+template <typename T>
+T* LocalPool<T>::alloc() {
+    if (free_.empty()) {
+        if (has_deferred_.load(std::memory_order_acquire)) {
+            take_deferred();
+        }
+        if (free_.empty()) {
+            grow();
+        }
+    }
+    T* item = free_.back();
+    free_.pop_back();
+    ++nalloc_;
+    maxget_ = std::max(++nget_, maxget_);
+    return item;
+}
+
+template <typename T>
+void LocalPool<T>::hpfree(T* item) {
+    if (owner_calling()) {
+        assert(nget_ > 0);
+        free_.push_back(item);
+        --nget_;
+    } else {
+        std::lock_guard<std::mutex> lock{deferred_mut_};
+        deferred_.push_back(item);
+        ++nremote_free_;
+        has_deferred_.store(true, std::memory_order_release);
+    }
+}
+
+template <typename T>
+void LocalPool<T>::free_all() {
+    {
+        std::lock_guard<std::mutex> lock{deferred_mut_};
+        deferred_.clear();
+        has_deferred_.store(false, std::memory_order_relaxed);
+    }
+    free_.clear();
+    for (std::size_t c = 0; c < chunks_.size(); ++c) {
+        T* chunk = chunks_[c].get();
+        for (long i = chunk_sizes_[c] - 1; i >= 0; --i) {
+            chunk[i].clear();
+            free_.push_back(chunk + i);
+        }
+    }
+    nget_ = 0;
+}
@@ -8,6 +8,7 @@
 
 #include "tqueue.hpp"
 #include "pool.hpp"
+#include "calendarq.hpp"
 
 #define PROFILE 0
 #include "profile.h"
@@ -38,6 +39,11 @@ of struct _spblk, we are really using TQItem
 #define key       t_
 #include <sptree.hpp>
 
+bool nrn_use_calendar_queue_;
+
+// The items not in least_ or the bin queue are in exactly one of these.
+#define EVENTSET(call) (calq_ ? calq_->call : sptree_->call)
+
 // extern double dt;
 #define nt_dt nrn_threads->_dt
 
@@ -60,7 +66,13 @@ TQueue::TQueue(TQItemPool* tp, int mkmut) {
     MUTCONSTRUCT(mkmut)
     tpool_ = tp;
     nshift_ = 0;
-    sptree_ = new SPTree<TQItem>();
+    if (nrn_use_calendar_queue_) {
+        calq_ = new CalendarQ<TQItem>();
+        sptree_ = nullptr;
+    } else {
+        calq_ = nullptr;
+        sptree_ = new SPTree<TQItem>();
+    }
     binq_ = new BinQ;
     least_ = 0;
 
@@ -72,10 +84,11 @@ TQueue::TQueue(TQItemPool* tp, int mkmut) {
 
 TQueue::~TQueue() {
     TQItem *q, *q2;
-    while ((q = sptree_->dequeue()) != nullptr) {
+    while ((q = EVENTSET(dequeue())) != nullptr) {
         deleteitem(q);
     }
     delete sptree_;
+    delete calq_;
     for (q = binq_->first(); q; q = q2) {
         q2 = binq_->next(q);
         remove(q);
@@ -93,7 +106,7 @@ void TQueue::print() {
     if (least_) {
         prnt(least_, 0);
     }
-    sptree_->apply_all(prnt, nullptr);
+    EVENTSET(apply_all(prnt, nullptr));
     for (TQItem* q = binq_->first(); q; q = binq_->next(q)) {
         prnt(q, 0);
     }
@@ -105,7 +118,7 @@ void TQueue::forall_callback(void (*f)(const TQItem*, int)) {
     if (least_) {
         f(least_, 0);
     }
-    sptree_->apply_all(f, nullptr);
+    EVENTSET(apply_all(f, nullptr));
     for (TQItem* q = binq_->first(); q; q = binq_->next(q)) {
         f(q, 0);
     }
@@ -118,7 +131,7 @@ void TQueue::check(const char* mes) {}
 // Assume not using bin queue.
 TQItem* TQueue::second_least(double t) {
     assert(least_);
-    TQItem* b = sptree_->first();
+    TQItem* b = EVENTSET(first());
     if (b && b->t_ == t) {
         return b;
     }
@@ -135,11 +148,11 @@ void TQueue::move_least_nolock(double tnew) {
     TQItem* b = least();
     if (b) {
         b->t_ = tnew;
-        TQItem* nl = sptree_->first();
+        TQItem* nl = EVENTSET(first());
         if (nl) {
             if (tnew > nl->t_) {
-                least_ = sptree_->dequeue();
-                sptree_->enqueue(b);
+                least_ = EVENTSET(dequeue());
+                EVENTSET(enqueue(b));
             }
         }
     }
@@ -151,14 +164,14 @@ void TQueue::move(TQItem* i, double tnew) {
     if (i == least_) {
         move_least_nolock(tnew);
     } else if (tnew < least_->t_) {
-        sptree_->remove(i);
+        EVENTSET(remove(i));
         i->t_ = tnew;
-        sptree_->enqueue(least_);
+        EVENTSET(enqueue(least_));
         least_ = i;
     } else {
-        sptree_->remove(i);
+        EVENTSET(remove(i));
         i->t_ = tnew;
-        sptree_->enqueue(i);
+        EVENTSET(enqueue(i));
     }
     MUTUNLOCK
 }
@@ -171,7 +184,11 @@ void TQueue::statistics() {
            nrem,
            nleast);
     Printf("calls to find=%lu\n", nfind);
-    Printf("comparisons=%d\n", sptree_->get_enqcmps());
+    if (calq_) {
+        Printf("calendar queue resizes=%d\n", calq_->get_nresize());
+    } else {
+        Printf("comparisons=%d\n", sptree_->get_enqcmps());
+    }
 #else
     Printf("Turn on COLLECT_TQueue_STATISTICS_ in tqueue.hpp\n");
 #endif
@@ -196,11 +213,11 @@ TQItem* TQueue::insert(double t, void* d) {
     i->cnt_ = -1;
     if (t < least_t_nolock()) {
         if (least()) {
-            sptree_->enqueue(least());
+            EVENTSET(enqueue(least()));
         }
         least_ = i;
     } else {
-        sptree_->enqueue(i);
+        EVENTSET(enqueue(i));
     }
     MUTUNLOCK
     return i;
@@ -227,15 +244,15 @@ void TQueue::remove(TQItem* q) {
     STAT(nrem);
     if (q) {
         if (q == least_) {
-            if (!sptree_->empty()) {
-                least_ = sptree_->dequeue();
+            if (!EVENTSET(empty())) {
+                least_ = EVENTSET(dequeue());
             } else {
                 least_ = nullptr;
             }
         } else if (q->cnt_ >= 0) {
             binq_->remove(q);
         } else {
-            sptree_->remove(q);
+            EVENTSET(remove(q));
         }
         tpool_->hpfree(q);
     }
@@ -248,8 +265,8 @@ TQItem* TQueue::atomic_dq(double tt) {
     if (least_ && least_->t_ <= tt) {
         q = least_;
         STAT(nrem);
-        if (!sptree_->empty()) {
-            least_ = sptree_->dequeue();
+        if (!EVENTSET(empty())) {
+            least_ = EVENTSET(dequeue());
         } else {
             least_ = nullptr;
         }
@@ -266,7 +283,7 @@ TQItem* TQueue::find(double t) {
     if (t == least_t_nolock()) {
         q = least();
     } else {
-        q = sptree_->find(t);
+        q = EVENTSET(find(t));
     }
     MUTUNLOCK
     return (q);
@@ -9,7 +9,7 @@
 
 #include "tqitem.hpp"
 
-using TQItemPool = MutexPool<TQItem>;
+using TQItemPool = LocalPool<TQItem>;
 
 // bin queue for the fixed step method for NetCons and PreSyns. Splay tree
 // for others.
@@ -24,6 +24,11 @@ using TQItemPool = MutexPool<TQItem>;
 #define COLLECT_TQueue_STATISTICS 1
 template <typename T>
 class SPTree;
+template <typename T>
+class CalendarQ;
+
+// TQueue constructed while true use a CalendarQ instead of an SPTree.
+extern bool nrn_use_calendar_queue_;
 
 // helper class for the TQueue (SplayTBinQueue).
 class BinQ {
@@ -134,6 +139,7 @@ class TQueue {
     }
     void move_least_nolock(double tnew);
     SPTree<TQItem>* sptree_;
+    CalendarQ<TQItem>* calq_;
     BinQ* binq_;
     TQItem* least_;
     TQItemPool* tpool_;
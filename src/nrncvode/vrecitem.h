@@ -4,6 +4,10 @@
 #include <netcon.h>
 #include <ivocvect.h>
 
+#include <cstdio>
+#include <string>
+#include <vector>
+
 class PlayRecord;
 class PlayRecordSave;
 class VecRecordDiscreteSave;
@@ -12,6 +16,7 @@ class VecPlayContinuousSave;
 class StmtInfo;
 struct NrnThread;
 struct Section;
+struct OcPtrVector;
 
 // SaveState subtypes for PlayRecordType and trajectory return type
 #define VecRecordDiscreteType 1
@@ -327,3 +332,44 @@ class VecPlayContinuousSave: public PlayRecordSave {
     int discon_index_;
     int ubound_index_;
 };
+
+// PtrVector.record(ybuf [, "file", chunk]). The values of all the pointers of
+// a PtrVector are recorded every step into the single time-major Vector ybuf,
+// i.e. row i, consisting of ncol_ values, holds the values at the i'th
+// recording time. The pointers are grouped by NrnThread at record_init.
+// With more than one thread each thread stages its rows in its own buffer
+// and commit copies them into ybuf after the threads have joined, so ybuf
+// is only resized by the main thread. If a file is given, the rows are
+// appended to it (native binary doubles) whenever ybuf holds chunk rows.
+class ColumnRecord: public Observer {
+  public:
+    ColumnRecord(OcPtrVector*, IvocVect* y, const char* fname, std::size_t chunk);
+    virtual ~ColumnRecord();
+    void record_init();
+    void continuous(NrnThread& nt);  // fixed step, the values owned by nt
+    void continuous();               // all the values, from the main thread
+    void commit();                   // after a join of the threads
+    void flush();                    // write the rows of y_ to the file
+    void columns_changed();          // PtrVector resized, stop until record_init
+    std::size_t nrow() const {
+        return ncol_ ? y_->size() / ncol_ : 0;
+    }
+
+    virtual void disconnect(Observable*);
+    virtual void update(Observable* o) {
+        disconnect(o);
+    }
+
+    OcPtrVector* pv_;
+    IvocVect* y_;
+    std::string fname_;
+    std::size_t chunk_;
+    FILE* f_{};
+    std::size_t ncol_{};
+    std::vector<std::vector<std::size_t>> cols_;  // per thread, the columns it owns
+    std::vector<std::vector<double>> staged_;     // per thread, rows of the values of cols_
+    std::vector<std::size_t> nstaged_;            // per thread, number of staged rows
+
+  private:
+    double* new_row();
+};
@@ -175,6 +175,8 @@ callback to bbss_early when needed.
 #include "nrnran123.h"
 #include "ocfile.h"
 #include <cmath>
+#include <cstdint>
+#include <future>
 #include <nrnmpiuse.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -182,12 +184,19 @@ callback to bbss_early when needed.
 #include <sys/stat.h>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "netcon.h"
 #include "nrniv_mf.h"
 #include "tqueue.hpp"
 #include "vrecitem.h"
 
+#if NRNMPI
+#include "nrnmpi.h"
+#include "have2want.hpp"
+#endif
+
 // on mingw, OUT became defined
 #undef IN
 #undef OUT
@@ -224,6 +233,7 @@ extern int nrnmpi_int_allmax(int);
 extern void nrnmpi_int_allgather(int* s, int* r, int n);
 extern void nrnmpi_int_allgatherv(int* s, int* r, int* n, int* dspl);
 extern void nrnmpi_dbl_allgatherv(double* s, double* r, int* n, int* dspl);
+extern double nrnmpi_dbl_allreduce(double x, int type);
 #else
 static void nrnmpi_barrier() {}
 static void nrnmpi_int_alltoallv(const int* s,
@@ -249,6 +259,9 @@ static void nrnmpi_dbl_alltoallv(const double* s,
 static int nrnmpi_int_allmax(int x) {
     return x;
 }
+static double nrnmpi_dbl_allreduce(double x, int type) {
+    return x;
+}
 static void nrnmpi_int_allgather(int* s, int* r, int n) {
     for (int i = 0; i < n; ++i) {
         r[i] = s[i];
@@ -268,6 +281,7 @@ static void nrnmpi_dbl_allgatherv(double* s, double* r, int* n, int* dspl) {
 
 #if NRNMPI
 extern bool use_multisend_;
+extern bool use_overlap_exchange_;
 #endif
 
 extern void nrn_play_init();
@@ -867,8 +881,9 @@ void bbss_restore_done(void* bbss) {
     delete npe;
     nrn_spike_exchange(nrn_threads);
 #if NRNMPI
-    // only necessary if multisend method is using two subintervals
-    if (use_multisend_) {
+    // only necessary if multisend method is using two subintervals or the
+    // exchange overlaps with computation
+    if (use_multisend_ || use_overlap_exchange_) {
         nrn_spike_exchange(nrn_threads);
     }
 #endif
@@ -987,6 +1002,306 @@ static double restore_test_bin(void* v) {  // assumes whole cells
     return 0.;
 }
 
+/*
+Parallel binary checkpoint. save_bin(dir) writes one file per rank,
+dir/bbss.<rank>, containing the records of the gids on that rank:
+
+  int32 version, int32 nhost, int32 rank, int32 ngid, double t
+  ngid times: int32 gid, int32 size, size bytes (as from bbss_save)
+
+The records are serialized into memory on the calling thread, which is
+all the simulation waits for, and the file is written by a background
+thread while the simulation continues. save_wait() waits for that write to
+finish (so does the next save_bin or restore_bin).
+
+restore_bin(dir) reads, on each rank, the files whose rank index is
+congruent to this rank modulo nhost, so with the same number of ranks each
+rank reads only its own file. Gids wanted by a rank that are not in the
+files it read are obtained from the ranks that did read them. In that case
+a gid may appear in only one file, i.e. cells must not have been split
+across ranks at save time.
+*/
+
+static constexpr int32_t bbss_bin_version = 1;
+static constexpr std::size_t bbss_bin_header = 4 * sizeof(int32_t) + sizeof(double);
+static std::future<std::string> bbss_bin_pending;
+
+static std::string bbss_bin_fname(const char* dir, int rank) {
+    return std::string(dir) + "/bbss." + std::to_string(rank);
+}
+
+// Write buf to fname (via a temporary so an interrupted write never leaves
+// a truncated checkpoint). Returns an error message, empty on success.
+static std::string bbss_bin_write(std::string fname, std::vector<char> buf) {
+    std::string tmp = fname + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "wb");
+    if (!f) {
+        return "could not open " + tmp;
+    }
+    bool ok = fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+    ok = (fclose(f) == 0) && ok;
+    if (!ok || rename(tmp.c_str(), fname.c_str()) != 0) {
+        return "could not write " + fname;
+    }
+    return "";
+}
+
+static void bbss_bin_wait() {
+    if (bbss_bin_pending.valid()) {
+        std::string err = bbss_bin_pending.get();
+        if (!err.empty()) {
+            hoc_execerr_ext("BBSaveState.save_bin: %s", err.c_str());
+        }
+    }
+}
+
+template <typename T>
+static void bbss_bin_put(char*& p, T x) {
+    memcpy(p, &x, sizeof(T));
+    p += sizeof(T);
+}
+
+template <typename T>
+static T bbss_bin_get(const char*& p) {
+    T x;
+    memcpy(&x, p, sizeof(T));
+    p += sizeof(T);
+    return x;
+}
+
+static double save_bin(void* v) {
+    const char* dir = gargstr(1);
+    bbss_bin_wait();
+    int len, *gids, *sizes, global_size;
+    void* ref = bbss_buffer_counts(&len, &gids, &sizes, &global_size);
+    std::size_t total = bbss_bin_header;
+    for (int i = 0; i < len; ++i) {
+        total += 2 * sizeof(int32_t) + sizes[i];
+    }
+    std::vector<char> buf(total);
+    char* p = buf.data();
+    bbss_bin_put<int32_t>(p, bbss_bin_version);
+    bbss_bin_put<int32_t>(p, nrnmpi_numprocs);
+    bbss_bin_put<int32_t>(p, nrnmpi_myid);
+    bbss_bin_put<int32_t>(p, len);
+    bbss_bin_put<double>(p, nrn_threads->_t);
+    for (int i = 0; i < len; ++i) {
+        bbss_bin_put<int32_t>(p, gids[i]);
+        bbss_bin_put<int32_t>(p, sizes[i]);
+        bbss_save(ref, gids[i], p, sizes[i]);
+        p += sizes[i];
+    }
+    assert(p == buf.data() + total);
+    if (len) {
+        free(gids);
+        free(sizes);
+    }
+    bbss_save_done(ref);
+
+#ifdef MINGW
+    mkdir(dir);
+#else
+    mkdir(dir, 0770);
+#endif
+    bbss_bin_pending = std::async(std::launch::async,
+                                  bbss_bin_write,
+                                  bbss_bin_fname(dir, nrnmpi_myid),
+                                  std::move(buf));
+#if !NRN_ENABLE_THREADS
+    bbss_bin_wait();
+#endif
+    return double(total);
+}
+
+static double save_wait(void* v) {
+    bbss_bin_wait();
+    return 0.;
+}
+
+// gid -> pieces (pointer, size) of that gid's records
+using BBSSBinRecords = std::unordered_map<int, std::vector<std::pair<const char*, int>>>;
+
+static void bbss_bin_index(const std::vector<char>& file,
+                           const std::string& fname,
+                           BBSSBinRecords& records,
+                           int& nhost_save,
+                           double& tsave) {
+    const char* p = file.data();
+    const char* end = p + file.size();
+    if (file.size() < bbss_bin_header || bbss_bin_get<int32_t>(p) != bbss_bin_version) {
+        hoc_execerr_ext("BBSaveState.restore_bin: %s is not a BBSaveState binary file",
+                        fname.c_str());
+    }
+    nhost_save = bbss_bin_get<int32_t>(p);
+    p += sizeof(int32_t);  // rank at save time
+    int ngid = bbss_bin_get<int32_t>(p);
+    tsave = bbss_bin_get<double>(p);
+    for (int i = 0; i < ngid; ++i) {
+        if (end - p < 2 * sizeof(int32_t)) {
+            hoc_execerr_ext("BBSaveState.restore_bin: %s is truncated", fname.c_str());
+        }
+        int gid = bbss_bin_get<int32_t>(p);
+        int sz = bbss_bin_get<int32_t>(p);
+        if (end - p < sz) {
+            hoc_execerr_ext("BBSaveState.restore_bin: %s is truncated", fname.c_str());
+        }
+        records[gid].emplace_back(p, sz);
+        p += sz;
+    }
+}
+
+#if NRNMPI
+static void bbss_bin_alltoallv(Data<int>& s, Data<int>& r) {
+    nrnmpi_int_alltoallv(
+        s.data.data(), s.cnt.data(), s.displ.data(), r.data.data(), r.cnt.data(), r.displ.data());
+}
+
+// Send the records of gids read on this rank to the ranks that want them.
+// The received records are returned in recv, indexed by records.
+static void bbss_bin_exchange(BBSSBinRecords& records,
+                              const std::vector<int>& want,
+                              std::vector<char>& recv) {
+    std::vector<int> have;
+    have.reserve(records.size());
+    for (const auto& r: records) {
+        if (r.second.size() > 1) {
+            hoc_execerr_ext(
+                "BBSaveState.restore_bin: gid %d was split at save time and cannot be moved to "
+                "another rank",
+                r.first);
+        }
+        have.push_back(r.first);
+    }
+    auto [send_to_want, recv_from_have] = have_to_want<int>(have, want, bbss_bin_alltoallv);
+    int nhost = nrnmpi_numprocs;
+
+    // sizes first, then the bytes, in the key order given by have_to_want
+    std::vector<int> ssz(send_to_want.displ[nhost]);
+    std::vector<int> rsz(recv_from_have.displ[nhost]);
+    for (std::size_t i = 0; i < ssz.size(); ++i) {
+        ssz[i] = records[send_to_want.data[i]][0].second;
+    }
+    nrnmpi_int_alltoallv(ssz.data(),
+                         send_to_want.cnt.data(),
+                         send_to_want.displ.data(),
+                         rsz.data(),
+                         recv_from_have.cnt.data(),
+                         recv_from_have.displ.data());
+    std::vector<int> scnt(nhost), sdispl(nhost + 1), rcnt(nhost), rdispl(nhost + 1);
+    for (int r = 0; r < nhost; ++r) {
+        for (int i = send_to_want.displ[r]; i < send_to_want.displ[r + 1]; ++i) {
+            scnt[r] += ssz[i];
+        }
+        for (int i = recv_from_have.displ[r]; i < recv_from_have.displ[r + 1]; ++i) {
+            rcnt[r] += rsz[i];
+        }
+        sdispl[r + 1] = sdispl[r] + scnt[r];
+        rdispl[r + 1] = rdispl[r] + rcnt[r];
+    }
+    std::vector<char> sbuf(sdispl[nhost] + 1);
+    char* p = sbuf.data();
+    for (int key: send_to_want.data) {
+        const auto& rec = records[key][0];
+        memcpy(p, rec.first, rec.second);
+        p += rec.second;
+    }
+    recv.resize(rdispl[nhost] + 1);
+    nrnmpi_char_alltoallv(
+        sbuf.data(), scnt.data(), sdispl.data(), recv.data(), rcnt.data(), rdispl.data());
+
+    // wanted records now come from recv (gids wanted here and also read here
+    // come back to this rank through the exchange as well)
+    records.clear();
+    const char* q = recv.data();
+    for (std::size_t i = 0; i < rsz.size(); ++i) {
+        records[recv_from_have.data[i]].emplace_back(q, rsz[i]);
+        q += rsz[i];
+    }
+}
+#endif  // NRNMPI
+
+static double restore_bin(void* v) {
+    const char* dir = gargstr(1);
+    bbss_bin_wait();
+    usebin_ = 1;
+
+    // read this rank's share of the files. File 0 says how many there are
+    // (the directory may hold stale files from an earlier save on more ranks)
+    std::vector<std::vector<char>> files;
+    BBSSBinRecords records;
+    int nhost_save = 0;
+    double tsave = 0.;
+    auto read_file = [&](int i) {
+        std::string fname = bbss_bin_fname(dir, i);
+        FILE* f = fopen(fname.c_str(), "rb");
+        if (!f) {
+            hoc_execerr_ext("BBSaveState.restore_bin: could not open %s", fname.c_str());
+        }
+        fseek(f, 0, SEEK_END);
+        files.emplace_back(ftell(f));
+        fseek(f, 0, SEEK_SET);
+        nrn_assert(fread(files.back().data(), 1, files.back().size(), f) == files.back().size());
+        fclose(f);
+        bbss_bin_index(files.back(), fname, records, nhost_save, tsave);
+    };
+    if (nrnmpi_myid == 0) {
+        read_file(0);
+    }
+    nhost_save = nrnmpi_int_allmax(nhost_save);
+    tsave = nrnmpi_dbl_allreduce(nrnmpi_myid == 0 ? tsave : -1e300, 2);
+    for (int i = nrnmpi_myid; i < nhost_save; i += nrnmpi_numprocs) {
+        if (i > 0) {
+            read_file(i);
+        }
+    }
+    nrn_threads->_t = tsave;
+    t = tsave;
+    bbss_restore_begin();
+
+    int len, *gids, *sizes, global_size;
+    void* ref = bbss_buffer_counts(&len, &gids, &sizes, &global_size);
+    int missing = 0;
+    for (int i = 0; i < len; ++i) {
+        if (!records.count(gids[i])) {
+            missing = 1;
+            break;
+        }
+    }
+    std::vector<char> recv;
+    if (nrnmpi_int_allmax(missing)) {
+#if NRNMPI
+        std::vector<int> want(gids, gids + len);
+        bbss_bin_exchange(records, want, recv);
+#else
+        hoc_execerror("BBSaveState.restore_bin: a gid on this rank is not in", dir);
+#endif
+    }
+    std::vector<char> piece;
+    for (int i = 0; i < len; ++i) {
+        auto it = records.find(gids[i]);
+        if (it == records.end()) {
+            hoc_execerr_ext("BBSaveState.restore_bin: gid %d not in %s", gids[i], dir);
+        }
+        auto& pieces = it->second;
+        if (pieces.size() == 1) {
+            bbss_restore(ref, gids[i], 1, (char*) pieces[0].first, pieces[0].second);
+        } else {
+            // concatenate the pieces of a cell split over several ranks
+            piece.clear();
+            for (auto& pc: pieces) {
+                piece.insert(piece.end(), pc.first, pc.first + pc.second);
+            }
+            bbss_restore(ref, gids[i], pieces.size(), piece.data(), piece.size());
+        }
+    }
+    if (len) {
+        free(gids);
+        free(sizes);
+    }
+    bbss_restore_done(ref);
+    return double(len);
+}
+
 static double vector_play_init(void* v) {
     nrn_play_init();
     return 0.;
@@ -999,6 +1314,10 @@ static Member_func members[] = {{"save", save},
                                 // binary test
                                 {"save_test_bin", save_test_bin},
                                 {"restore_test_bin", restore_test_bin},
+                                // parallel binary checkpoint, one file per rank
+                                {"save_bin", save_bin},
+                                {"save_wait", save_wait},
+                                {"restore_bin", restore_bin},
                                 // binary save/restore interface to interpreter
                                 {"save_request", save_request},
                                 {"save_gid", save_gid},
@@ -26,7 +26,7 @@ extern void Graph_reg(), HBox_reg(), VBox_reg(), GUIMath_reg(), PWManager_reg(),
 #if USEBBS
     ParallelContext_reg(),
 #endif
-    NMODLRandom_reg();
+    NMODLRandom_reg(), LFP_reg();
 
 void hoc_class_registration(void) {
     void (*register_classes[])() =
@@ -70,6 +70,7 @@ void hoc_class_registration(void) {
       StateTransitionEvent_reg,
       nrnpython_reg,
       NMODLRandom_reg,
+      LFP_reg,
 #if USEDASPK
       Daspk_reg,
 #endif
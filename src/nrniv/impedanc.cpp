@@ -5,10 +5,16 @@
 #include "nrn_ansi.h"
 #include "nonlinz.h"
 #include <InterViews/resource.h>
+#include <algorithm>
 #include <complex>
+#include <utility>
+#include <vector>
 #include "nrnoc2iv.h"
 #include "classreg.h"
 #include "membfunc.h"
+#include "multicore.h"
+#include "ivocvect.h"
+#include "ocmatrix.h"
 
 typedef void (*Pfrv4)(int, Node**, double**, Datum**);
 
@@ -24,6 +30,15 @@ class Imp {
     double transfer_phase(Section*, double);
     double input_phase(Section*, double);
     double ratio_amp(Section*, double);
+    // amplitude and phase at many frequencies (rows) and locations (columns)
+    int sweep(Vect* freq,
+              std::vector<std::pair<Section*, double>> const& locs,
+              Matrix* tamp,
+              Matrix* tphase,
+              Matrix* iamp,
+              Matrix* iphase,
+              bool nonlin = false,
+              int maxiter = 500);
 
   private:
     int loc(Section*, double);
@@ -38,6 +53,7 @@ class Imp {
 
   public:
     double deltafac_ = .001;
+    int nthread_ = 1;  // for sweep
 
   private:
     int n = 0;
@@ -136,6 +152,54 @@ static double deltafac(void* v) {
     return imp->deltafac_;
 }
 
+static double sweep(void* v) {
+    Imp* imp = (Imp*) v;
+    Vect* freq = vector_arg(1);
+    Object* o = *hoc_objgetarg(2);
+    check_obj_type(o, "SectionList");
+    Vect* x = vector_arg(3);
+    Matrix* tamp = matrix_arg(4);
+    Matrix* tphase = matrix_arg(5);
+    Matrix* iamp = nullptr;
+    Matrix* iphase = nullptr;
+    if (ifarg(6)) {
+        iamp = matrix_arg(6);
+        iphase = matrix_arg(7);
+    }
+    bool nonlin = false;
+    int maxiter = 500;
+    if (ifarg(8)) {
+        nonlin = *getarg(8) ? true : false;
+    }
+    if (ifarg(9)) {
+        maxiter = int(chkarg(9, 1, 1e9));
+    }
+    std::vector<std::pair<Section*, double>> locs;
+    SectionList* sl = new SectionList(o);
+    sl->ref();
+    for (Section* sec = sl->begin(); sec && locs.size() < x->size(); sec = sl->next()) {
+        locs.emplace_back(sec, x->elem(locs.size()));
+    }
+    sl->unref();
+    if (locs.size() != x->size()) {
+        hoc_execerror("Impedance.sweep:", "fewer sections than locations");
+    }
+    for (auto const& loc: locs) {
+        if (loc.second < 0. || loc.second > 1.) {
+            hoc_execerror("Impedance.sweep:", "location not in the range 0 to 1");
+        }
+    }
+    return double(imp->sweep(freq, locs, tamp, tphase, iamp, iphase, nonlin, maxiter));
+}
+
+static double nthread(void* v) {
+    Imp* imp = (Imp*) v;
+    if (ifarg(1)) {
+        imp->nthread_ = int(chkarg(1, 1, 1e4));
+    }
+    return imp->nthread_;
+}
+
 static Member_func members[] = {{"compute", compute},
                                 {"loc", location},
                                 {"input", input_amp},
@@ -144,6 +208,8 @@ static Member_func members[] = {{"compute", compute},
                                 {"input_phase", input_phase},
                                 {"transfer_phase", transfer_phase},
                                 {"deltafac", deltafac},
+                                {"sweep", sweep},
+                                {"nthread", nthread},
                                 {nullptr, nullptr}};
 
 void Impedance_reg() {
@@ -279,6 +345,163 @@ int Imp::compute(double freq, bool nonlin, int maxiter) {
     return rval;
 }
 
+namespace {
+// Frequency independent part of the linear problem, gathered once by
+// Imp::sweep. Every task solves a strided subset of the frequencies with its
+// own work arrays, with the same arithmetic as Imp::setmat, Imp::LUDecomp and
+// Imp::solve.
+struct ImpSweep {
+    int n, ncell, istim;
+    std::vector<double> a, b, g, c, area;  // NODEA, NODEB, NODED, capacitance, NODEAREA
+    std::vector<int> parent;
+    std::vector<int> vlocs;
+    Vect* freq;
+    std::size_t ntask;
+    bool input;
+    std::vector<std::complex<double>> tvals, ivals;  // [ifreq * nloc + iloc]
+};
+
+void imp_sweep_task(void* data, std::size_t itask) {
+    auto* const sw = static_cast<ImpSweep*>(data);
+    int const n = sw->n;
+    std::size_t const nloc = sw->vlocs.size();
+    std::vector<std::complex<double>> d(n), pivot(n), transfer(n), input(n);
+    for (std::size_t k = itask; k < sw->freq->size(); k += sw->ntask) {
+        double omega = 1e-6 * 2 * 3.14159265358979323846 * sw->freq->elem(k);
+        for (int i = 0; i < n; ++i) {
+            d[i] = std::complex<double>(sw->g[i], sw->c[i] * omega);
+            transfer[i] = 0.;
+        }
+        transfer[sw->istim] = 1.e2 / sw->area[sw->istim];
+        for (int i = n - 1; i >= sw->ncell; --i) {
+            int ip = sw->parent[i];
+            pivot[i] = sw->a[i] / d[i];
+            d[ip] -= pivot[i] * sw->b[i];
+        }
+        for (int i = sw->istim; i >= sw->ncell; --i) {
+            transfer[sw->parent[i]] -= transfer[i] * pivot[i];
+        }
+        for (int i = 0; i < sw->ncell; ++i) {
+            transfer[i] /= d[i];
+            input[i] = 1. / d[i];
+        }
+        for (int i = sw->ncell; i < n; ++i) {
+            int ip = sw->parent[i];
+            transfer[i] -= sw->b[i] * transfer[ip];
+            transfer[i] /= d[i];
+            if (sw->input) {
+                input[i] = (std::complex<double>(1) + input[ip] * pivot[i] * sw->b[i]) / d[i];
+            }
+        }
+        for (std::size_t j = 0; j < nloc; ++j) {
+            int i = sw->vlocs[j];
+            sw->tvals[k * nloc + j] = transfer[i];
+            if (sw->input) {
+                sw->ivals[k * nloc + j] = i < sw->ncell ? input[i]
+                                                        : input[i] * (1e2 / sw->area[i]);
+            }
+        }
+    }
+}
+}  // namespace
+
+int Imp::sweep(Vect* freq,
+               std::vector<std::pair<Section*, double>> const& locs,
+               Matrix* tamp,
+               Matrix* tphase,
+               Matrix* iamp,
+               Matrix* iphase,
+               bool nonlin,
+               int maxiter) {
+    int rval = 0;
+    int const nfreq = freq->size();
+    int const nloc = locs.size();
+    tamp->resize(nfreq, nloc);
+    tphase->resize(nfreq, nloc);
+    if (iamp) {
+        iamp->resize(nfreq, nloc);
+        iphase->resize(nfreq, nloc);
+    }
+    if (nonlin) {
+        // the extended impedance has to be recomputed at each frequency
+        for (int k = 0; k < nfreq; ++k) {
+            rval = compute(freq->elem(k), true, maxiter);
+            for (int j = 0; j < nloc; ++j) {
+                Section* sec = locs[j].first;
+                double x = locs[j].second;
+                tamp->coeff(k, j) = transfer_amp(sec, x);
+                tphase->coeff(k, j) = transfer_phase(sec, x);
+                if (iamp) {
+                    iamp->coeff(k, j) = input_amp(sec, x);
+                    iphase->coeff(k, j) = input_phase(sec, x);
+                }
+            }
+        }
+        return rval;
+    }
+    check();
+    if (!sloc_) {
+        hoc_execerror("Impedance stimulus location is not specified.", 0);
+    }
+    istim = loc(sloc_, xloc_);
+    if (n == 0 || nfreq == 0 || nloc == 0) {
+        return rval;
+    }
+    setmat1();
+    const NrnThread* _nt = nrn_threads;
+    ImpSweep sw{};
+    sw.n = n;
+    sw.ncell = _nt->ncell;
+    sw.istim = istim;
+    sw.a.resize(n);
+    sw.b.resize(n);
+    sw.g.resize(n);
+    sw.c.resize(n);
+    sw.area.resize(n);
+    sw.parent.resize(n);
+    for (int i = 0; i < n; ++i) {
+        Node* nd = _nt->_v_node[i];
+        sw.a[i] = NODEA(nd);
+        sw.b[i] = NODEB(nd);
+        sw.g[i] = NODED(nd);
+        sw.c[i] = NODERHS(nd);
+        sw.area[i] = NODEAREA(nd);
+        sw.parent[i] = i < _nt->ncell ? i : _nt->_v_parent[i]->v_node_index;
+    }
+    for (auto const& l: locs) {
+        sw.vlocs.push_back(loc(l.first, l.second));
+    }
+    sw.freq = freq;
+    sw.ntask = std::min(nthread_, nfreq);
+    sw.input = iamp != nullptr;
+    sw.tvals.resize(std::size_t(nfreq) * nloc);
+    if (sw.input) {
+        sw.ivals.resize(std::size_t(nfreq) * nloc);
+    }
+    // more worker threads only for the duration of the sweep
+    int const nworker = nrn_multitask_nworker();
+    if (nthread_ > nworker) {
+        nrn_multitask_nworker(nthread_);
+    }
+    nrn_multitask(sw.ntask, imp_sweep_task, &sw);
+    if (nthread_ > nworker) {
+        nrn_multitask_nworker(nworker);
+    }
+    for (int k = 0; k < nfreq; ++k) {
+        for (int j = 0; j < nloc; ++j) {
+            std::complex<double> z = sw.tvals[std::size_t(k) * nloc + j];
+            tamp->coeff(k, j) = abs(z);
+            tphase->coeff(k, j) = arg(z);
+            if (sw.input) {
+                z = sw.ivals[std::size_t(k) * nloc + j];
+                iamp->coeff(k, j) = abs(z);
+                iphase->coeff(k, j) = arg(z);
+            }
+        }
+    }
+    return rval;
+}
+
 void Imp::setmat(double omega) {
     const NrnThread* _nt = nrn_threads;
     setmat1();
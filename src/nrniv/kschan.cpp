@@ -10,6 +10,8 @@
 #include "parse.hpp"
 #include "nrniv_mf.h"
 
+#include <algorithm>
+
 #define NSingleIndex 0
 
 using KSChanList = std::vector<KSChan*>;
@@ -243,6 +245,14 @@ static double ks_single(void* v) {
     return (ks->is_single() ? 1. : 0.);
 }
 
+static double ks_batch(void* v) {
+    KSChan* ks = (KSChan*) v;
+    if (ifarg(1)) {
+        ks->use_batch(((int) chkarg(1, 0, 1)) != 0);
+    }
+    return (ks->use_batch() ? 1. : 0.);
+}
+
 static double ks_iv_type(void* v) {
     KSChan* ks = (KSChan*) v;
     if (ifarg(1)) {
@@ -699,6 +709,7 @@ static Member_func ks_dmem[] = {
     {"nligand", ks_nligand},
     {"is_point", ks_is_point},
     {"single", ks_single},
+    {"batch", ks_batch},
     {"pr", ks_pr},
 
     {"iv_type", ks_iv_type},
@@ -2150,6 +2161,157 @@ void KSChan::setupmat() {
     for (i = 0; i < nksstate_; ++i) {
         diag_[i] = spGetElement(mat_, i + 1, i + 1);
     }
+    setupbatch();
+}
+
+// Symbolic LU factorization, without pivoting, of the kinetic scheme matrix.
+void KSChan::setupbatch() {
+    int n = nksstate_;
+    std::vector<char> nz(n * n, 0);
+    auto at = [n](int i, int j) { return i * n + j; };
+    for (int i = 0; i < n; ++i) {
+        nz[at(i, i)] = 1;
+    }
+    for (int i = ivkstrans_; i < ntrans_; ++i) {
+        int s = trans_[i].src_ - nhhstate_;
+        int t = trans_[i].target_ - nhhstate_;
+        nz[at(s, t)] = nz[at(t, s)] = 1;
+    }
+    // fill-in
+    for (int k = 0; k < n; ++k) {
+        for (int i = k + 1; i < n; ++i) {
+            if (nz[at(i, k)]) {
+                for (int j = k + 1; j < n; ++j) {
+                    if (nz[at(k, j)]) {
+                        nz[at(i, j)] = 1;
+                    }
+                }
+            }
+        }
+    }
+    std::vector<int> slot(n * n, -1);
+    bnnz_ = 0;
+    for (int i = 0; i < n * n; ++i) {
+        if (nz[i]) {
+            slot[i] = bnnz_++;
+        }
+    }
+    btslot_.clear();
+    for (int i = ivkstrans_; i < ntrans_; ++i) {
+        int s = trans_[i].src_ - nhhstate_;
+        int t = trans_[i].target_ - nhhstate_;
+        btslot_.insert(btslot_.end(), {slot[at(s, s)], slot[at(s, t)], slot[at(t, t)], slot[at(t, s)]});
+    }
+    bdslot_.resize(n);
+    for (int i = 0; i < n; ++i) {
+        bdslot_[i] = slot[at(i, i)];
+    }
+    belim_.clear();
+    bupd_.clear();
+    for (int k = 0; k < n; ++k) {
+        for (int i = k + 1; i < n; ++i) {
+            if (nz[at(i, k)]) {
+                BatchElim e{i, k, slot[at(i, k)], slot[at(k, k)], int(bupd_.size()), 0};
+                for (int j = k + 1; j < n; ++j) {
+                    if (nz[at(k, j)]) {
+                        bupd_.emplace_back(slot[at(i, j)], slot[at(k, j)]);
+                        ++e.nupd;
+                    }
+                }
+                belim_.push_back(e);
+            }
+        }
+    }
+    bback_.clear();
+    bback_row_.resize(n + 1);
+    for (int i = 0; i < n; ++i) {
+        bback_row_[i] = int(bback_.size());
+        for (int j = i + 1; j < n; ++j) {
+            if (nz[at(i, j)]) {
+                bback_.emplace_back(slot[at(i, j)], j);
+            }
+        }
+    }
+    bback_row_[n] = int(bback_.size());
+}
+
+// The batched equivalent of fillmat, mat_dt, and solvemat for the listed
+// instances.
+void KSChan::batch_solve(NrnThread* nt,
+                         Memb_list* ml,
+                         std::size_t offset,
+                         double dt,
+                         std::vector<std::size_t> const& instances) {
+    constexpr std::size_t B = 64;  // instances per block
+    int const n = nksstate_;
+    double const dt1 = -1. / dt;
+    auto* const vec_v = nt->node_voltage_storage();
+    std::vector<double> am(bnnz_ * B), bm(n * B);
+    double* const a = am.data();
+    double* const b = bm.data();
+    for (std::size_t ib = 0; ib < instances.size(); ib += B) {
+        std::size_t const nl = std::min(B, instances.size() - ib);
+        std::fill(am.begin(), am.end(), 0.);
+        for (std::size_t l = 0; l < nl; ++l) {
+            auto const inst = instances[ib + l];
+            double const v = vec_v[ml->nodeindices[inst]];
+            int j = 0;
+            for (int i = ivkstrans_; i < ntrans_; ++i) {
+                double al, be;
+                if (i < iligtrans_) {
+                    trans_[i].ab(v, al, be);
+                } else {
+                    al = trans_[i].alpha(ml->pdata[inst]);
+                    be = trans_[i].beta();
+                }
+                a[btslot_[j++] * B + l] -= al;
+                a[btslot_[j++] * B + l] += be;
+                a[btslot_[j++] * B + l] -= be;
+                a[btslot_[j++] * B + l] += al;
+            }
+            for (int i = 0; i < n; ++i) {
+                a[bdslot_[i] * B + l] += dt1;
+                b[i * B + l] = ml->data(inst, offset + i) * dt1;
+            }
+        }
+        for (auto const& e: belim_) {
+            double* const aik = a + e.ik * B;
+            double const* const akk = a + e.kk * B;
+            double* const bi = b + e.i * B;
+            double const* const bk = b + e.k * B;
+            for (std::size_t l = 0; l < nl; ++l) {
+                aik[l] /= akk[l];
+                bi[l] -= aik[l] * bk[l];
+            }
+            for (int u = e.upd; u < e.upd + e.nupd; ++u) {
+                double* const aij = a + bupd_[u].first * B;
+                double const* const akj = a + bupd_[u].second * B;
+                for (std::size_t l = 0; l < nl; ++l) {
+                    aij[l] -= aik[l] * akj[l];
+                }
+            }
+        }
+        for (int i = n - 1; i >= 0; --i) {
+            double* const bi = b + i * B;
+            for (int u = bback_row_[i]; u < bback_row_[i + 1]; ++u) {
+                double const* const aij = a + bback_[u].first * B;
+                double const* const bj = b + bback_[u].second * B;
+                for (std::size_t l = 0; l < nl; ++l) {
+                    bi[l] -= aij[l] * bj[l];
+                }
+            }
+            double const* const aii = a + bdslot_[i] * B;
+            for (std::size_t l = 0; l < nl; ++l) {
+                bi[l] /= aii[l];
+            }
+        }
+        for (std::size_t l = 0; l < nl; ++l) {
+            auto const inst = instances[ib + l];
+            for (int i = 0; i < n; ++i) {
+                ml->data(inst, offset + i) = b[i * B + l];
+            }
+        }
+    }
 }
 
 void KSChan::fillmat(double v, Datum* pd) {
@@ -2498,7 +2660,9 @@ void KSChan::init(NrnThread* nt, Memb_list* ml) {
     int n = ml->nodecount;
     Node** nd = ml->nodelist;
     Datum** ppd = ml->pdata;
+    bool const batch = use_batch_ && nksstate_;
     if (nstate_) {
+        std::vector<std::size_t> instances;
         for (int i = 0; i < n; ++i) {
             double v = NODEV(nd[i]);
             auto offset = soffset_;
@@ -2511,12 +2675,21 @@ void KSChan::init(NrnThread* nt, Memb_list* ml) {
             for (int j = 0; j < nhhstate_; ++j) {
                 ml->data(i, offset + j) = trans_[j].inf(v);
             }
-            if (nksstate_) {
+            if (batch) {
+                instances.push_back(i);
+            } else if (nksstate_) {
                 offset += nhhstate_;
                 fillmat(v, ppd[i]);
                 mat_dt(1e9, ml, i, offset);
                 solvemat(ml, i, offset);
             }
+        }
+        if (batch) {
+            batch_solve(nt, ml, soffset_ + nhhstate_, 1e9, instances);
+        }
+        for (int i = 0; i < n; ++i) {
+            double v = NODEV(nd[i]);
+            auto offset = soffset_ + (nksstate_ ? nhhstate_ : 0);
             if (is_single()) {
                 auto* snd = ppd[i][2].get<KSSingleNodeData*>();
                 snd->nsingle_ = int(ml->data(i, NSingleIndex) + .5);
@@ -2536,7 +2709,9 @@ void KSChan::state(NrnThread* _nt, Memb_list* ml) {
     Node** nd = ml->nodelist;
     Datum** ppd = ml->pdata;
     auto* const vec_v = _nt->node_voltage_storage();
+    bool const batch = use_batch_ && nksstate_;
     if (nstate_) {
+        std::vector<std::size_t> instances;
         for (int i = 0; i < n; ++i) {
             if (is_single() && ml->data(i, NSingleIndex) > .999) {
                 single_->state(nd[i], ppd[i], _nt);
@@ -2574,13 +2749,18 @@ void KSChan::state(NrnThread* _nt, Memb_list* ml) {
                     ml->data(i, offset + j) += (inf - ml->data(i, offset + j)) * tau;
                 }
             }
-            if (nksstate_) {
+            if (batch) {
+                instances.push_back(i);
+            } else if (nksstate_) {
                 offset += nhhstate_;
                 fillmat(v, ppd[i]);
                 mat_dt(_nt->_dt, ml, i, offset);
                 solvemat(ml, i, offset);
             }
         }
+        if (batch) {
+            batch_solve(_nt, ml, soffset_ + nhhstate_, _nt->_dt, instances);
+        }
     }
 }
 
@@ -3003,7 +3183,9 @@ void KSChan::matsol(NrnThread* nt, Memb_list* ml) {
     Node** nd = ml->nodelist;
     Datum** ppd = ml->pdata;
     int i, j;
-    if (nstate_)
+    bool const batch = use_batch_ && nksstate_;
+    if (nstate_) {
+        std::vector<std::size_t> instances;
         for (i = 0; i < n; ++i) {
             if (is_single() && ml->data(i, NSingleIndex) > .999) {
                 continue;
@@ -3015,13 +3197,19 @@ void KSChan::matsol(NrnThread* nt, Memb_list* ml) {
                 tau = trans_[j].tau(v);
                 ml->data(i, offset + j) /= (1 + nt->_dt / tau);
             }
-            if (nksstate_) {
+            if (batch) {
+                instances.push_back(i);
+            } else if (nksstate_) {
                 offset += nhhstate_;
                 fillmat(v, ppd[i]);
                 mat_dt(nt->_dt, ml, i, offset);
                 solvemat(ml, i, offset);
             }
         }
+        if (batch) {
+            batch_solve(nt, ml, soffset_ + nstate_ + nhhstate_, nt->_dt, instances);
+        }
+    }
 }
 
 // from Cvode::do_nonode
@@ -7,6 +7,9 @@
 
 #include "spmatrix.h"
 
+#include <utility>
+#include <vector>
+
 // extern double dt;
 extern double celsius;
 
@@ -399,6 +402,12 @@ class KSChan {
         return usetable_;
     }
     void check_table_thread(NrnThread*);
+    bool use_batch() {
+        return use_batch_;
+    }
+    void use_batch(bool b) {
+        use_batch_ = b;
+    }
 
   private:
     void free1();
@@ -407,6 +416,12 @@ class KSChan {
     void mat_dt(double dt, Memb_list* ml, std::size_t instance, std::size_t offset);
     void solvemat(Memb_list*, std::size_t instance, std::size_t offset);
     void mulmat(Memb_list* ml, std::size_t instance, std::size_t offset_s, std::size_t offset_ds);
+    void setupbatch();
+    void batch_solve(NrnThread*,
+                     Memb_list*,
+                     std::size_t offset,
+                     double dt,
+                     std::vector<std::size_t> const& instances);
     void ion_consist();
     void ligand_consist(int, int, Prop*, Node*);
     Prop* needion(Symbol*, Node*, Prop*);
@@ -471,6 +486,25 @@ class KSChan {
     char* mat_;
     double** elms_;
     double** diag_;
+    // Batched alternative to mat_. All instances share the sparsity pattern,
+    // so the LU fill-in and the elimination sequence are computed once by
+    // setupbatch and batch_solve applies them to many instances at a time.
+    // Values are stored as [slot][instance] so the loops over instances
+    // vectorize. No pivoting is needed since the matrix, rates minus 1/dt on
+    // the diagonal, is strictly column diagonally dominant.
+    struct BatchElim {
+        int i, k;       // row and pivot
+        int ik, kk;     // slots of a(i,k) and a(k,k)
+        int upd, nupd;  // range in bupd_
+    };
+    bool use_batch_{false};
+    int bnnz_{};                              // number of slots
+    std::vector<int> btslot_;                 // ks transition elements, in elms_ order
+    std::vector<int> bdslot_;                 // diagonal elements
+    std::vector<BatchElim> belim_;            // in pivot order
+    std::vector<std::pair<int, int>> bupd_;   // slot of a(i,j), slot of a(k,j)
+    std::vector<std::pair<int, int>> bback_;  // slot of a(i,j), j. By row.
+    std::vector<int> bback_row_;              // row i is [bback_row_[i], bback_row_[i+1])
     int dsize_;       // size of prop->dparam
     int psize_;       // size of prop->param
     int soffset_;     // STATE begins here in the p array.
@@ -0,0 +1,321 @@
+#include <../../nrnconf.h>
+
+/*
+LFP: extracellular potentials recorded during a simulation
+    lfp = new LFP(xvec, yvec, zvec [, sigma, point_source])
+    lfp.record(yvec [, tvec] [, nstep])  every nstep steps, all electrodes appended
+    lfp.record_remove()
+    lfp.value(i)
+    lfp.nelectrode()
+*/
+
+#include "classreg.h"
+#include "coreneuron/io/lfp_kernel.hpp"
+#include "ivocvect.h"
+#include "lfp.h"
+#include "netcvode.h"
+#include "nrn_ansi.h"
+#include "nrnoc2iv.h"
+#include "section.h"
+
+#include <algorithm>
+#include <cmath>
+#include <nrnmpiuse.h>
+#include <stdexcept>
+#include <utility>
+
+#if NRNMPI
+#include "nrnmpi.h"
+#endif
+
+extern NetCvode* net_cvode_instance;
+extern int hoc_return_type_code;
+extern void nrn_define_shape();
+
+namespace {
+using Point = LFP::Point;
+using namespace coreneuron::lfputils;
+
+// position and diameter at arc length a along the 3-d points of sec
+std::pair<Point, double> at_arc(Section* sec, double a) {
+    Pt3d const* p = sec->pt3d;
+    int const n = sec->npt3d;
+    int i = 1;
+    while (i < n - 1 && p[i].arc < a) {
+        ++i;
+    }
+    double const da = p[i].arc - p[i - 1].arc;
+    double const w = da > 0.0 ? std::clamp((a - p[i - 1].arc) / da, 0.0, 1.0) : 0.0;
+    auto lerp = [w](double u, double v) { return u + w * (v - u); };
+    return {{lerp(p[i - 1].x, p[i].x), lerp(p[i - 1].y, p[i].y), lerp(p[i - 1].z, p[i].z)},
+            lerp(p[i - 1].d, p[i].d)};
+}
+}  // namespace
+
+LFP::LFP(std::vector<Point> electrodes, double sigma, bool point_source)
+    : electrodes_{std::move(electrodes)}
+    , sigma_{sigma}
+    , point_source_{point_source}
+    , value_(electrodes_.size(), 0.0) {}
+
+LFP::~LFP() {
+    record_remove();
+}
+
+void LFP::record(IvocVect* y, IvocVect* t, int nstep) {
+    record_remove();
+    y_ = y;
+    t_ = t;
+    nstep_ = nstep;
+    ObjObservable::Attach(y_->obj_, this);
+    if (t_) {
+        ObjObservable::Attach(t_->obj_, this);
+    }
+    net_cvode_instance->lfp_.push_back(this);
+}
+
+void LFP::record_remove() {
+    if (!y_) {
+        return;
+    }
+    // rows staged but not yet committed are dropped, the reduction over ranks
+    // is only done from the collective nrn_record_commit
+    ObjObservable::Detach(y_->obj_, this);
+    if (t_) {
+        ObjObservable::Detach(t_->obj_, this);
+    }
+    y_ = nullptr;
+    t_ = nullptr;
+    thread_.clear();
+    auto& l = net_cvode_instance->lfp_;
+    l.erase(std::remove(l.begin(), l.end(), this), l.end());
+}
+
+void LFP::disconnect(Observable*) {
+    record_remove();
+}
+
+void LFP::record_init() {
+    if (net_cvode_instance->is_local()) {
+        hoc_execerror("LFP.record", "not allowed with the local variable time step method");
+    }
+    if (!nrn_use_fast_imem) {
+        hoc_execerror("LFP.record", "requires CVode.use_fast_imem(1)");
+    }
+    nrn_define_shape();
+    std::size_t const ne = electrodes_.size();
+    tile_ = lfp_tile_size(ne);
+    npadded_ = (ne + tile_ - 1) / tile_ * tile_;
+    thread_.assign(nrn_nthread, {});
+
+    // the segments of each thread, as straight lines between the 3-d points
+    // at their ends
+    struct Segment {
+        int node;
+        Point p0, p1;
+        double radius;
+    };
+    std::vector<std::vector<Segment>> segments(nrn_nthread);
+    hoc_Item* qsec;
+    // ForAllSections(sec)
+    ITERATE(qsec, section_list) {
+        Section* sec = hocSEC(qsec);
+        if (sec->npt3d < 2 || sec->nnode < 2) {
+            continue;
+        }
+        int const nseg = sec->nnode - 1;
+        double const len = sec->pt3d[sec->npt3d - 1].arc;
+        auto& seg = segments[sec->pnode[0]->_nt->id];
+        for (int i = 0; i < nseg; ++i) {
+            auto const p0 = at_arc(sec, len * i / nseg);
+            auto const p1 = at_arc(sec, len * (i + 1) / nseg);
+            auto const mid = at_arc(sec, len * (i + 0.5) / nseg);
+            seg.push_back({sec->pnode[i]->v_node_index, p0.first, p1.first, 0.5 * mid.second});
+        }
+    }
+
+    // the potential at the electrode in mV per nA of the segment current
+    double const f = 1.0 / (4.0 * M_PI * sigma_);
+    for (int it = 0; it < nrn_nthread; ++it) {
+        auto const& seg = segments[it];
+        auto& tf = thread_[it];
+        std::size_t const nseg = seg.size();
+        tf.node.resize(nseg);
+        tf.current.resize(nseg);
+        tf.factor.assign(npadded_ * nseg, 0.0);
+        for (std::size_t s = 0; s < nseg; ++s) {
+            tf.node[s] = seg[s].node;
+            for (std::size_t e = 0; e < ne; ++e) {
+                double factor{};
+                try {
+                    factor = point_source_
+                                 ? point_source_lfp_factor(electrodes_[e],
+                                                           barycenter(seg[s].p0, seg[s].p1),
+                                                           seg[s].radius,
+                                                           f)
+                                 : line_source_lfp_factor(
+                                       electrodes_[e], seg[s].p0, seg[s].p1, seg[s].radius, f);
+                } catch (std::invalid_argument const& err) {
+                    thread_.clear();
+                    hoc_execerror("LFP:", err.what());
+                }
+                tf.factor[((e / tile_) * nseg + s) * tile_ + e % tile_] = factor;
+            }
+        }
+    }
+    std::fill(value_.begin(), value_.end(), 0.0);
+    y_->vec().clear();
+    if (t_) {
+        t_->vec().clear();
+    }
+}
+
+// partial potentials of the segments of nt into out (npadded_ values)
+void LFP::partial(ThreadFactors& tf, NrnThread& nt, double* out) {
+    std::size_t const nseg = tf.node.size();
+    std::size_t const ntile = npadded_ / tile_;
+    if (nseg == 0) {
+        std::fill(out, out + npadded_, 0.0);
+        return;
+    }
+    double const* imem = nt.node_sav_rhs_storage();
+    for (std::size_t s = 0; s < nseg; ++s) {
+        tf.current[s] = imem[tf.node[s]];
+    }
+    lfp_tiles(tile_, nseg, ntile, tf.factor.data(), tf.current.data(), out);
+}
+
+void LFP::stage(NrnThread& nt) {
+    auto& tf = thread_[nt.id];
+    if (tf.count++ % nstep_) {
+        return;
+    }
+    std::size_t const k = tf.staged.size();
+    tf.staged.resize(k + npadded_);
+    partial(tf, nt, tf.staged.data() + k);
+    tf.staged_t.push_back(nt._t);
+    ++tf.nstaged;
+}
+
+void LFP::continuous(NrnThread& nt) {
+    if (thread_.size() != std::size_t(nrn_nthread)) {
+        return;  // no record_init since LFP.record or nthread changed
+    }
+    stage(nt);
+}
+
+void LFP::continuous() {
+    if (thread_.size() != std::size_t(nrn_nthread)) {
+        return;
+    }
+    for (int it = 0; it < nrn_nthread; ++it) {
+        stage(nrn_threads[it]);
+    }
+}
+
+void LFP::commit() {
+    if (thread_.empty()) {
+        return;
+    }
+    std::size_t n = thread_[0].nstaged;
+    for (auto const& tf: thread_) {
+        n = std::min(n, tf.nstaged);
+    }
+#if NRNMPI
+    // the same number of rows on every rank, as the count of the reduction
+    if (nrnmpi_numprocs > 1) {
+        n = std::size_t(-nrnmpi_int_allmax(-int(n)));
+    }
+#endif
+    if (n == 0) {
+        return;
+    }
+    // sum over threads, always in the same order
+    std::vector<double> rows(n * npadded_, 0.0);
+    for (auto& tf: thread_) {
+        for (std::size_t i = 0; i < n * npadded_; ++i) {
+            rows[i] += tf.staged[i];
+        }
+    }
+#if NRNMPI
+    if (nrnmpi_numprocs > 1) {
+        std::vector<double> sum(rows.size());
+        nrnmpi_dbl_allreduce_vec(rows.data(), sum.data(), int(rows.size()), 1);
+        rows.swap(sum);
+    }
+#endif
+    std::size_t const ne = electrodes_.size();
+    auto& y = y_->vec();
+    y_->grow_capacity(y.size() + n * ne);
+    for (std::size_t r = 0; r < n; ++r) {
+        y.insert(y.end(), rows.begin() + r * npadded_, rows.begin() + r * npadded_ + ne);
+    }
+    std::copy(rows.end() - npadded_, rows.end() - npadded_ + ne, value_.begin());
+    if (t_) {
+        auto& tv = t_->vec();
+        tv.insert(tv.end(), thread_[0].staged_t.begin(), thread_[0].staged_t.begin() + n);
+    }
+    for (auto& tf: thread_) {
+        tf.staged.erase(tf.staged.begin(), tf.staged.begin() + n * npadded_);
+        tf.staged_t.erase(tf.staged_t.begin(), tf.staged_t.begin() + n);
+        tf.nstaged -= n;
+    }
+}
+
+static void* lfp_cons(Object*) {
+    IvocVect* x = vector_arg(1);
+    IvocVect* y = vector_arg(2);
+    IvocVect* z = vector_arg(3);
+    if (x->size() != y->size() || x->size() != z->size()) {
+        hoc_execerror("LFP:", "the x, y and z Vectors must have the same size");
+    }
+    std::vector<LFP::Point> electrodes;
+    for (std::size_t i = 0; i < x->size(); ++i) {
+        electrodes.push_back({x->elem(i), y->elem(i), z->elem(i)});
+    }
+    double sigma = ifarg(4) ? chkarg(4, 1e-9, 1e9) : 0.3;
+    bool point_source = ifarg(5) ? bool(chkarg(5, 0., 1.)) : false;
+    return new LFP(std::move(electrodes), sigma, point_source);
+}
+
+static void lfp_destruct(void* v) {
+    delete static_cast<LFP*>(v);
+}
+
+static double record(void* v) {
+    IvocVect* y = vector_arg(1);
+    IvocVect* t = nullptr;
+    int ia = 2;
+    if (ifarg(ia) && hoc_is_object_arg(ia)) {
+        t = vector_arg(ia);
+        ++ia;
+    }
+    int nstep = ifarg(ia) ? int(chkarg(ia, 1., 1e9)) : 1;
+    static_cast<LFP*>(v)->record(y, t, nstep);
+    return 0.;
+}
+
+static double record_remove(void* v) {
+    static_cast<LFP*>(v)->record_remove();
+    return 0.;
+}
+
+static double value(void* v) {
+    auto* lfp = static_cast<LFP*>(v);
+    return lfp->value(std::size_t(chkarg(1, 0., double(lfp->nelectrode()) - 1.)));
+}
+
+static double nelectrode(void* v) {
+    hoc_return_type_code = 1;  // integer
+    return double(static_cast<LFP*>(v)->nelectrode());
+}
+
+static Member_func members[] = {{"record", record},
+                                {"record_remove", record_remove},
+                                {"value", value},
+                                {"nelectrode", nelectrode},
+                                {nullptr, nullptr}};
+
+void LFP_reg() {
+    class2oc("LFP", lfp_cons, lfp_destruct, members, nullptr, nullptr);
+}
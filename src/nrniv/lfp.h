@@ -0,0 +1,68 @@
+#pragma once
+
+#include "ocobserv.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+class IvocVect;
+struct NrnThread;
+
+// Extracellular potential at a set of electrodes from the i_membrane_ of all
+// the segments, see the LFP class. At record_init each thread gets the
+// electrode x segment transfer factors of its own segments, stored in tiles
+// of tile_ electrodes so that a tile of partial sums stays in registers while
+// the segments are streamed. Every nstep_ steps each thread gathers its
+// currents into a contiguous buffer and stages its partial potentials;
+// commit, from nrn_record_commit on the main thread after the threads have
+// joined, sums them over threads and ranks and appends a row of nelectrode
+// values to the record Vector. As it reduces over the ranks, commit is only
+// called where all the ranks call it.
+class LFP: public Observer {
+  public:
+    using Point = std::array<double, 3>;
+    LFP(std::vector<Point> electrodes, double sigma, bool point_source);
+    virtual ~LFP();
+    void record(IvocVect* y, IvocVect* t, int nstep);
+    void record_remove();
+    void record_init();
+    void continuous(NrnThread& nt);  // fixed step, the segments of nt
+    void continuous();               // all the segments, from the main thread
+    void commit();                   // after a join of the threads, collective
+    std::size_t nelectrode() const {
+        return electrodes_.size();
+    }
+    double value(std::size_t i) const {
+        return i < value_.size() ? value_[i] : 0.0;
+    }
+
+    virtual void disconnect(Observable*);
+    virtual void update(Observable* o) {
+        disconnect(o);
+    }
+
+  private:
+    struct ThreadFactors {
+        std::vector<int> node;         // v_node_index of each segment
+        std::vector<double> factor;    // [tile][segment][electrode in tile]
+        std::vector<double> current;   // gathered i_membrane_
+        std::vector<double> staged;    // rows of partial potentials
+        std::vector<double> staged_t;  // the time of each row
+        std::size_t nstaged{};
+        std::size_t count{};  // steps since record_init
+    };
+    void partial(ThreadFactors& tf, NrnThread& nt, double* out);
+    void stage(NrnThread& nt);
+
+    std::vector<Point> electrodes_;
+    double sigma_;
+    bool point_source_;
+    IvocVect* y_{};
+    IvocVect* t_{};
+    int nstep_{1};
+    std::size_t tile_{1};    // electrodes per tile
+    std::size_t npadded_{};  // electrodes rounded up to tiles
+    std::vector<ThreadFactors> thread_;
+    std::vector<double> value_;  // potentials of the last committed row
+};
@@ -131,6 +131,19 @@ class Multisend_ReceiveBuffer {
 
 static int use_phase2_;
 
+// Neighborhood collective exchange. The target host lists computed for
+// multisend define a distributed graph topology and the spikes generated
+// in an interval are exchanged with MPI_Neighbor_alltoallv at the end of
+// the interval instead of with MPI_Isend, MPI_Iprobe, and the
+// conservation check. In this mode, target_hosts_ holds indices into the
+// destination list of the graph instead of ranks.
+static bool use_neighbor_;
+static std::vector<std::vector<NRNMPI_Spike>> neighbor_sbuf_;  // per destination
+static std::vector<NRNMPI_Spike> neighbor_spikeout_;
+static std::vector<int> neighbor_scnt_, neighbor_sdispl_;
+static NRNMPI_Spike* neighbor_spikein_;
+static int neighbor_icapacity_;
+
 class Multisend_Send {
   public:
     Multisend_Send() = default;
@@ -228,9 +241,8 @@ void Multisend_ReceiveBuffer::enqueue() {
 #if 1
     for (int i = 0; i < count_; ++i) {
         NRNMPI_Spike* spk = buffer_[i];
-        auto iter = gid2in_.find(spk->gid);
-        nrn_assert(iter != gid2in_.end());
-        PreSyn* ps = iter->second;
+        PreSyn* ps = gid2in_index_.find(spk->gid);
+        nrn_assert(ps);
         if (use_phase2_ && ps->bgp.multisend_send_phase2_) {
             // cannot do directly because busy_;
             // ps->bgp.multisend_send_phase2_->send_phase2(spk->gid, spk->spiketime, this);
@@ -351,11 +363,13 @@ double nrn_multisend_receive_time(int type) {  // and others
              // bit 3: number of phases, 0 means 1 phase, 1 means 2
              // bit 4: unused (1 used to mean althash used)
              // bit 5: 1 means enqueue separated into two parts for timeing
+             // bit 7: 1 means neighborhood collective (MPI_Neighbor_alltoallv)
+             // bit 8: 1 means overlapped allgather (MPI_Iallgather)
     {
         int method = use_multisend_ ? 1 : 0;
         int p = method + 4 * (n_multisend_interval == 2 ? 1 : 0) + 8 * use_phase2_ +
                 16 * (0)  // no hash selection, just std::unordered_map
-                + 32 * ENQUEUE;
+                + 32 * ENQUEUE + 128 * use_neighbor_ + 256 * use_overlap_exchange_;
         rt = double(p);
     } break;
     case 12:  // greatest length multisend
@@ -371,6 +385,8 @@ extern void nrnmpi_multisend_comm();
 extern void nrnmpi_multisend_multisend(NRNMPI_Spike*, int, int*);
 extern int nrnmpi_multisend_single_advance(NRNMPI_Spike*);
 extern int nrnmpi_multisend_conserve(int nsend, int nrecv);
+extern void nrnmpi_neighbor_comm(int nsrc, int* srcs, int ndest, int* dests);
+extern int nrnmpi_neighbor_exchange(NRNMPI_Spike*, int*, int*, NRNMPI_Spike**, int*);
 
 static void nrn_multisend_init() {
     for (int i = 0; i < n_multisend_interval; ++i) {
@@ -404,7 +420,7 @@ static int multisend_advance() {
 
 #if NRNMPI
 void nrn_multisend_advance() {
-    if (use_multisend_) {
+    if (use_multisend_ && !use_neighbor_) {
         multisend_advance();
     }
 #if ENQUEUE == 2
@@ -445,7 +461,13 @@ void Multisend_Send::send(int gid, double t) {
             spk_.gid = ~spk_.gid;
         }
         nsend_ += 1;
-        if (use_multisend_) {
+        if (use_neighbor_) {
+            MUTLOCK
+            for (int i = 0; i < ntarget_hosts_; ++i) {
+                neighbor_sbuf_[target_hosts_[i]].push_back(spk_);
+            }
+            MUTUNLOCK
+        } else if (use_multisend_) {
             nrnmpi_multisend_multisend(&spk_, ntarget_hosts_phase1_, target_hosts_);
         }
     }
@@ -466,6 +488,35 @@ void Multisend_Send_Phase2::send_phase2(int gid, double t, Multisend_ReceiveBuff
     }
 }
 
+// Send the spikes of this interval to the graph neighbors and pass the
+// received spikes to the receive buffers as multisend_advance does.
+static void neighbor_exchange() {
+    std::size_t const ndest = neighbor_sbuf_.size();
+    neighbor_spikeout_.clear();
+    for (std::size_t i = 0; i < ndest; ++i) {
+        auto& sbuf = neighbor_sbuf_[i];
+        neighbor_sdispl_[i] = int(neighbor_spikeout_.size());
+        neighbor_scnt_[i] = int(sbuf.size());
+        neighbor_spikeout_.insert(neighbor_spikeout_.end(), sbuf.begin(), sbuf.end());
+        sbuf.clear();
+    }
+    int n = nrnmpi_neighbor_exchange(neighbor_spikeout_.data(),
+                                     neighbor_scnt_.data(),
+                                     neighbor_sdispl_.data(),
+                                     &neighbor_spikein_,
+                                     &neighbor_icapacity_);
+    for (int i = 0; i < n; ++i) {
+        NRNMPI_Spike& spk = neighbor_spikein_[i];
+        int j = 0;
+        if (spk.gid < 0) {
+            spk.gid = ~spk.gid;
+            j = 1;
+        }
+        multisend_receive_buffer[j]->incoming(spk.gid, spk.spiketime);
+    }
+    nrecv_ += n;
+}
+
 void nrn_multisend_receive(NrnThread* nt) {
     //	nrn_spike_exchange();
     assert(nt == nrn_threads);
@@ -475,7 +526,9 @@ void nrn_multisend_receive(NrnThread* nt) {
     int& s = multisend_receive_buffer[current_rbuf]->nsend_;
     int& r = multisend_receive_buffer[current_rbuf]->nrecv_;
     double w1 = nrnmpi_wtime();
-    if (use_multisend_) {
+    if (use_neighbor_) {
+        neighbor_exchange();
+    } else if (use_multisend_) {
         nrn_multisend_advance();
         TBUF
 #if TBUFSIZE
@@ -614,6 +667,45 @@ static void ensure_ntarget_gt_3(Multisend_Send* bs) {
 
 #include "multisend_setup.cpp"
 
+// The graph destinations are the union of the target hosts of the output
+// PreSyn and the graph sources are the ranks that have this rank in that
+// union.
+static void neighbor_setup() {
+    std::vector<int> sflag(nrnmpi_numprocs, 0), rflag(nrnmpi_numprocs, 0);
+    for (const auto& iter: gid2out_) {
+        Multisend_Send* bs = iter.second->bgp.multisend_send_;
+        if (bs) {
+            for (int i = 0; i < bs->ntarget_hosts_; ++i) {
+                sflag[bs->target_hosts_[i]] = 1;
+            }
+        }
+    }
+    nrnmpi_int_alltoall(sflag.data(), rflag.data(), 1);
+    std::vector<int> srcs, dests;
+    for (int i = 0; i < nrnmpi_numprocs; ++i) {
+        if (sflag[i]) {
+            sflag[i] = int(dests.size());  // rank to destination index
+            dests.push_back(i);
+        }
+        if (rflag[i]) {
+            srcs.push_back(i);
+        }
+    }
+    for (const auto& iter: gid2out_) {
+        Multisend_Send* bs = iter.second->bgp.multisend_send_;
+        if (bs) {
+            for (int i = 0; i < bs->ntarget_hosts_; ++i) {
+                bs->target_hosts_[i] = sflag[bs->target_hosts_[i]];
+            }
+        }
+    }
+    nrnmpi_neighbor_comm(int(srcs.size()), srcs.data(), int(dests.size()), dests.data());
+    neighbor_sbuf_.clear();
+    neighbor_sbuf_.resize(dests.size());
+    neighbor_scnt_.resize(dests.size() + 1);
+    neighbor_sdispl_.resize(dests.size() + 1);
+}
+
 void nrn_multisend_setup() {
     nrn_multisend_cleanup();
     if (!use_multisend_) {
@@ -635,6 +727,9 @@ void nrn_multisend_setup() {
 
     // completely new algorithm does one and two phase.
     setup_presyn_multisend_lists();
+    if (use_neighbor_) {
+        neighbor_setup();
+    }
 
     if (!multisend_receive_buffer[0]) {
         multisend_receive_buffer[0] = new Multisend_ReceiveBuffer();
@@ -27,6 +27,7 @@ using Gid2PreSyn = std::unordered_map<int, PreSyn*>;
 #include "ivocvect.h"
 
 #include <atomic>
+#include <utility>
 #include <vector>
 
 static int n_multisend_interval;
@@ -39,6 +40,10 @@ int nrnmusic;
 static Symbol* netcon_sym_;
 static Gid2PreSyn gid2out_;
 static Gid2PreSyn gid2in_;
+// Incoming spike dispatch uses gid2in_index_ instead of gid2in_. Any change to
+// gid2in_ must set gid2in_changed_ so the index is rebuilt before next use.
+static Gid2PreSynIndex gid2in_index_;
+static bool gid2in_changed_{true};
 static IvocVect* all_spiketvec = NULL;
 static IvocVect* all_spikegidvec = NULL;
 static double t_exchange_;
@@ -178,9 +183,10 @@ int ncs_target_hosts(int gid, int** targetnodes) {
 // for compressed gid info during spike exchange
 bool nrn_use_localgid_;
 void nrn_outputevent(unsigned char localgid, double firetime);
-static std::vector<std::unique_ptr<Gid2PreSyn>> localmaps_;
+// per rank, indexed by the unsigned char localgid. Empty for nrnmpi_myid.
+static std::vector<std::vector<PreSyn*>> localmaps_;
 
-static int nsend_, nsendmax_, nrecv_, nrecv_useful_;
+static int nsend_, nsendmax_, nrecv_, nrecv_useful_, nexchange_;
 static IvocVect* max_histogram_;
 
 static int ocapacity_;  // for spikeout_
@@ -194,6 +200,15 @@ static void nrn_spike_exchange_compressed(NrnThread*);
 
 #if NRNMPI
 bool use_multisend_;  // false: allgather, true: multisend (MPI_ISend)
+// Allgather started at the end of an interval and completed at the end of
+// the next with mindelay_ half the minimum interprocessor delay.
+bool use_overlap_exchange_;
+static bool ovl_pending_;  // an overlapped exchange is in flight
+static int ovl_nout_;
+static int ovl_ocapacity_;
+static NRNMPI_Spike* ovl_spikeout_;
+static void nrn_spike_exchange_overlap(NrnThread*);
+void nrn_spike_exchange_advance();
 static void nrn_multisend_setup();
 static void nrn_multisend_init();
 static void nrn_multisend_receive(NrnThread*);
@@ -219,6 +234,55 @@ Gid2PreSyn& nrn_gid2out() {
     return gid2out_;
 }
 
+void Gid2PreSynIndex::clear() {
+    gid_min_ = 1;
+    gid_max_ = 0;
+    gids_.clear();
+    presyns_.clear();
+    table_.clear();
+}
+
+void Gid2PreSynIndex::build(const Gid2PreSyn& map) {
+    clear();
+    std::vector<std::pair<int, PreSyn*>> items;
+    items.reserve(map.size());
+    for (const auto& iter: map) {
+        if (iter.second) {
+            items.emplace_back(iter.first, iter.second);
+        }
+    }
+    if (items.empty()) {
+        return;
+    }
+    std::sort(items.begin(), items.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    gids_.reserve(items.size());
+    presyns_.reserve(items.size());
+    for (const auto& item: items) {
+        gids_.push_back(item.first);
+        presyns_.push_back(item.second);
+    }
+    gid_min_ = gids_.front();
+    gid_max_ = gids_.back();
+    // A direct table costs one pointer per gid in the range. Worth it
+    // when that is not much more than the sorted arrays themselves.
+    std::size_t span = std::size_t(gid_max_) - std::size_t(gid_min_) + 1;
+    if (span <= 4 * gids_.size() + 1024) {
+        table_.assign(span, nullptr);
+        for (std::size_t i = 0; i < gids_.size(); ++i) {
+            table_[std::size_t(gids_[i]) - std::size_t(gid_min_)] = presyns_[i];
+        }
+    }
+}
+
+static void gid2in_index_update() {
+    if (gid2in_changed_) {
+        gid2in_index_.build(gid2in_);
+        gid2in_changed_ = false;
+    }
+}
+
 #if NRNMPI
 // for combination of threads and mpi.
 #if NRN_ENABLE_THREADS
@@ -443,9 +507,9 @@ static int nrn_need_npe() {
 
 static void calc_actual_mindelay() {
     // reasons why mindelay_ can be smaller than min_interprocessor_delay
-    // are use_multisend_
+    // are use_multisend_ and use_overlap_exchange_
 #if NRNMPI
-    if (use_multisend_ && n_multisend_interval == 2) {
+    if ((use_multisend_ && n_multisend_interval == 2) || use_overlap_exchange_) {
         mindelay_ = min_interprocessor_delay_ / 2.;
     } else {
         mindelay_ = min_interprocessor_delay_;
@@ -474,6 +538,13 @@ void nrn_spike_exchange_init() {
     }
     //	if (!active_ && !nrn_use_selfqueue_) { return; }
     alloc_space();
+#if NRNMPI
+    if (ovl_pending_) {  // left over from the previous run
+        nrnmpi_spike_exchange_finish();
+        ovl_pending_ = false;
+    }
+#endif
+    gid2in_index_update();
     // printf("nrnmpi_use=%d active=%d\n", nrnmpi_use, active_);
     calc_actual_mindelay();
     usable_mindelay_ = mindelay_;
@@ -532,7 +603,7 @@ void nrn_spike_exchange_init() {
 #endif
     }
     nout_ = 0;
-    nsend_ = nsendmax_ = nrecv_ = nrecv_useful_ = 0;
+    nsend_ = nsendmax_ = nrecv_ = nrecv_useful_ = nexchange_ = 0;
     if (nrnmpi_numprocs > 0) {
         if (nrn_nthread > 0) {
 #if NRN_ENABLE_THREADS
@@ -556,11 +627,17 @@ void nrn_spike_exchange(NrnThread* nt) {
     if (!active_) {
         return;
     }
+    gid2in_index_update();
+    ++nexchange_;
 #if NRNMPI
     if (use_multisend_) {
         nrn_multisend_receive(nt);
         return;
     }
+    if (use_overlap_exchange_ && !use_compress_) {
+        nrn_spike_exchange_overlap(nt);
+        return;
+    }
 #endif
     if (use_compress_) {
         nrn_spike_exchange_compressed(nt);
@@ -634,9 +711,8 @@ void nrn_spike_exchange(NrnThread* nt) {
             nn = nrn_spikebuf_size;
         }
         for (j = 0; j < nn; ++j) {
-            auto iter = gid2in_.find(spbufin_[i].gid[j]);
-            if (iter != gid2in_.end()) {
-                PreSyn* ps = iter->second;
+            PreSyn* ps = gid2in_index_.find(spbufin_[i].gid[j]);
+            if (ps) {
                 ps->send(spbufin_[i].spiketime[j], net_cvode_instance, nt);
                 ++nrecv_useful_;
             }
@@ -645,9 +721,8 @@ void nrn_spike_exchange(NrnThread* nt) {
     n = ovfl_;
 #endif  // nrn_spikebuf_size > 0
     for (i = 0; i < n; ++i) {
-        auto iter = gid2in_.find(spikein_[i].gid);
-        if (iter != gid2in_.end()) {
-            PreSyn* ps = iter->second;
+        PreSyn* ps = gid2in_index_.find(spikein_[i].gid);
+        if (ps) {
             ps->send(spikein_[i].spiketime, net_cvode_instance, nt);
             ++nrecv_useful_;
         }
@@ -656,6 +731,54 @@ void nrn_spike_exchange(NrnThread* nt) {
     TBUF
 }
 
+// Complete the exchange of the spikes of the previous interval, which are
+// not due before the end of this one, and start the exchange of the spikes
+// of this interval.
+static void nrn_spike_exchange_overlap(NrnThread* nt) {
+    double wt = nrnmpi_wtime();
+    int n = 0;
+    if (ovl_pending_) {
+        n = nrnmpi_spike_exchange_finish();
+        ovl_pending_ = false;
+    }
+    wt_ = nrnmpi_wtime() - wt;
+    wt = nrnmpi_wtime();
+    nrecv_ += n;
+    for (int i = 0; i < n; ++i) {
+        PreSyn* ps = gid2in_index_.find(spikein_[i].gid);
+        if (ps) {
+            ps->send(spikein_[i].spiketime, net_cvode_instance, nt);
+            ++nrecv_useful_;
+        }
+    }
+    nsend_ += nout_;
+    if (nsendmax_ < nout_) {
+        nsendmax_ = nout_;
+    }
+    // spikeout_ collects the spikes of the next interval while these are in
+    // flight
+    if (!ovl_spikeout_) {
+        ovl_ocapacity_ = 100;
+        ovl_spikeout_ = (NRNMPI_Spike*) hoc_Emalloc(ovl_ocapacity_ * sizeof(NRNMPI_Spike));
+        hoc_malchk();
+    }
+    std::swap(spikeout_, ovl_spikeout_);
+    std::swap(ocapacity_, ovl_ocapacity_);
+    ovl_nout_ = nout_;
+    nout_ = 0;
+    nrnmpi_spike_exchange_start(&ovl_nout_, nin_, ovl_spikeout_, &spikein_, &icapacity_);
+    ovl_pending_ = true;
+    wt1_ = nrnmpi_wtime() - wt;
+}
+
+// Called by thread 0 every fixed step so the MPI library can progress the
+// overlapped exchange.
+void nrn_spike_exchange_advance() {
+    if (ovl_pending_) {
+        nrnmpi_spike_exchange_advance();
+    }
+}
+
 void nrn_spike_exchange_compressed(NrnThread* nt) {
     if (!active_) {
         return;
@@ -737,7 +860,7 @@ void nrn_spike_exchange_compressed(NrnThread* nt) {
                     }
                     continue;
                 }
-                Gid2PreSyn* gps = localmaps_[i].get();
+                const std::vector<PreSyn*>& gps = localmaps_[i];
                 if (nn > ag_send_nspike_) {
                     nnn = ag_send_nspike_;
                 } else {
@@ -749,9 +872,8 @@ void nrn_spike_exchange_compressed(NrnThread* nt) {
                     double firetime = spfixin_[idx++] * dt + t_exchange_;
                     int lgid = (int) spfixin_[idx];
                     idx += localgid_size_;
-                    auto iter = gps->find(lgid);
-                    if (iter != gps->end()) {
-                        PreSyn* ps = iter->second;
+                    PreSyn* ps = gps[lgid];
+                    if (ps) {
                         ps->send(firetime + 1e-10, net_cvode_instance, nt);
                         ++nrecv_useful_;
                     }
@@ -760,9 +882,8 @@ void nrn_spike_exchange_compressed(NrnThread* nt) {
                     double firetime = spfixin_ovfl_[idxov++] * dt + t_exchange_;
                     int lgid = (int) spfixin_ovfl_[idxov];
                     idxov += localgid_size_;
-                    auto iter = gps->find(lgid);
-                    if (iter != gps->end()) {
-                        PreSyn* ps = iter->second;
+                    PreSyn* ps = gps[lgid];
+                    if (ps) {
                         ps->send(firetime + 1e-10, net_cvode_instance, nt);
                         ++nrecv_useful_;
                     }
@@ -782,9 +903,8 @@ void nrn_spike_exchange_compressed(NrnThread* nt) {
                 double firetime = spfixin_[idx++] * dt + t_exchange_;
                 int gid = spupk(spfixin_ + idx);
                 idx += localgid_size_;
-                auto iter = gid2in_.find(gid);
-                if (iter != gid2in_.end()) {
-                    PreSyn* ps = iter->second;
+                PreSyn* ps = gid2in_index_.find(gid);
+                if (ps) {
                     ps->send(firetime + 1e-10, net_cvode_instance, nt);
                     ++nrecv_useful_;
                 }
@@ -796,9 +916,8 @@ void nrn_spike_exchange_compressed(NrnThread* nt) {
             double firetime = spfixin_ovfl_[idx++] * dt + t_exchange_;
             int gid = spupk(spfixin_ovfl_ + idx);
             idx += localgid_size_;
-            auto iter = gid2in_.find(gid);
-            if (iter != gid2in_.end()) {
-                PreSyn* ps = iter->second;
+            PreSyn* ps = gid2in_index_.find(gid);
+            if (ps) {
                 ps->send(firetime + 1e-10, net_cvode_instance, nt);
                 ++nrecv_useful_;
             }
@@ -850,15 +969,14 @@ static void mk_localgid_rep() {
     delete[] sbuf;
     errno = 0;
 
-    // create the maps
-    // there is a lot of potential for efficiency here. i.e. use of
-    // perfect hash functions, or even simple Vectors.
+    // create the maps. Since a localgid fits in an unsigned char, each
+    // map is a simple 256 element table indexed by the localgid.
     localmaps_.clear();
     localmaps_.resize(nrnmpi_numprocs);
 
     for (int i = 0; i < nrnmpi_numprocs; ++i)
         if (i != nrnmpi_myid) {
-            localmaps_[i].reset(new Gid2PreSyn());
+            localmaps_[i].assign(256, nullptr);
         }
 
     // fill in the maps
@@ -869,8 +987,7 @@ static void mk_localgid_rep() {
             for (int k = 0; k < ngid; ++k) {
                 auto iter = gid2in_.find(int(sbuf[k]));
                 if (iter != gid2in_.end()) {
-                    PreSyn* ps = iter->second;
-                    (*localmaps_[i])[k] = ps;
+                    localmaps_[i][k] = iter->second;
                 }
             }
         }
@@ -981,6 +1098,7 @@ void nrn_cleanup_presyn(PreSyn* ps) {
     }
     if (ps->gid_ >= 0) {
         gid2in_.erase(ps->gid_);
+        gid2in_changed_ = true;
         ps->gid_ = -1;
     }
 }
@@ -1034,6 +1152,8 @@ void nrnmpi_gid_clear(int arg) {
     gid_donot_remove = 0;
     gid2in_.clear();
     gid2out_.clear();
+    gid2in_index_.clear();
+    gid2in_changed_ = true;
 }
 
 int nrn_gid_exists(int gid) {
@@ -1217,6 +1337,7 @@ Object** BBS::gid_connect(int gid) {
             ps = new PreSyn({}, nullptr, nullptr);
             net_cvode_instance->psl_append(ps);
             gid2in_[gid] = ps;
+            gid2in_changed_ = true;
             ps->gid_ = gid;
         }
     }
@@ -1296,6 +1417,10 @@ void BBS::netpar_solve(double tstop) {
         for (int i = 0; i < n_multisend_interval; ++i) {
             nrn_multisend_receive(nrn_threads);
         }
+    } else if (use_overlap_exchange_) {
+        // the second completes the exchange started by the first
+        nrn_spike_exchange(nrn_threads);
+        nrn_spike_exchange(nrn_threads);
     } else {
         nrn_spike_exchange(nrn_threads);
     }
@@ -1416,12 +1541,17 @@ double BBS::netpar_mindelay(double maxdelay) {
     return tt;
 }
 
-void BBS::netpar_spanning_statistics(int* nsend, int* nsendmax, int* nrecv, int* nrecv_useful) {
+void BBS::netpar_spanning_statistics(int* nsend,
+                                     int* nsendmax,
+                                     int* nrecv,
+                                     int* nrecv_useful,
+                                     int* nexchange) {
 #if NRNMPI
     *nsend = nsend_;
     *nsendmax = nsendmax_;
     *nrecv = nrecv_;
     *nrecv_useful = nrecv_useful_;
+    *nexchange = nexchange_;
 #endif
 }
 
@@ -1454,6 +1584,14 @@ The situation that needs to be captured by xchng_meth is
 
 0: Allgather
 1: multisend implemented as MPI_ISend
+32: Allgather implemented as MPI_Iallgather and MPI_Iallgatherv. The
+    integration interval is half the minimum interprocessor delay and the
+    exchange of the spikes of one interval completes at the end of the next
+    so that it overlaps with computation. Not used with spike compression.
+17: multisend target lists exchanged with MPI_Neighbor_alltoallv over a
+    distributed graph topology. Exchange cost scales with the number of
+    ranks a rank actually sends to and receives from. Two phase multisend
+    is not used in this mode.
 
 n_multisend_interval 1 or 2 per minimum interprocessor NetCon delay
  that concept valid for all methods
@@ -1489,6 +1627,11 @@ int nrnmpi_spike_compress(int nspike, bool gid_compress, int xchng_meth) {
         n_multisend_interval = (xchng_meth & 4) ? 2 : 1;
         use_multisend_ = (xchng_meth & 1) == 1;
         use_phase2_ = (xchng_meth & 8) ? 1 : 0;
+        use_neighbor_ = use_multisend_ && (xchng_meth & 16);
+        use_overlap_exchange_ = !use_multisend_ && (xchng_meth & 32);
+        if (use_neighbor_) {
+            use_phase2_ = 0;
+        }
         if (use_multisend_) {
             assert(NRNMPI);
         }
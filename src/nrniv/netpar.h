@@ -3,11 +3,52 @@
 // Some things in netpar.cpp that were static but needed by nrnmusic.cpp
 
 #include "netcon.h"
+#include <algorithm>
+#include <cstddef>
 #include <unordered_map>
+#include <vector>
 struct Symbol;
 
 using Gid2PreSyn = std::unordered_map<int, PreSyn*>;
 
+/**
+ * @brief Frozen gid -> PreSyn lookup used to dispatch incoming spikes.
+ *
+ * Built from a Gid2PreSyn (gid2in_) once the network is set up and rebuilt
+ * only when that map changes. When the gids are reasonably dense the lookup
+ * is a direct table indexed by gid - gid_min, otherwise a binary search over
+ * a sorted gid array. Either way the spike dispatch loop touches contiguous
+ * memory instead of hash buckets.
+ */
+class Gid2PreSynIndex {
+  public:
+    void build(const Gid2PreSyn& map);
+    void clear();
+    std::size_t size() const {
+        return gids_.size();
+    }
+    PreSyn* find(int gid) const {
+        if (gid < gid_min_ || gid > gid_max_) {
+            return nullptr;
+        }
+        if (!table_.empty()) {
+            return table_[std::size_t(gid) - std::size_t(gid_min_)];
+        }
+        auto it = std::lower_bound(gids_.begin(), gids_.end(), gid);
+        if (it != gids_.end() && *it == gid) {
+            return presyns_[it - gids_.begin()];
+        }
+        return nullptr;
+    }
+
+  private:
+    int gid_min_{1};
+    int gid_max_{0};  // empty range, every find fails
+    std::vector<int> gids_;
+    std::vector<PreSyn*> presyns_;
+    std::vector<PreSyn*> table_;  // direct lookup, only when gids are dense
+};
+
 double nrn_usable_mindelay();
 Symbol* nrn_netcon_sym();
 Gid2PreSyn& nrn_gid2out();
@@ -112,6 +112,8 @@ N_Vector N_VNewEmpty_NrnSerialLD(long int length) {
     ops->nvinvtest = N_VInvTest_NrnSerialLD;
     ops->nvconstrmask = N_VConstrMask_NrnSerialLD;
     ops->nvminquotient = N_VMinQuotient_NrnSerialLD;
+    ops->nvscalevectorarray = NULL;
+    ops->nvscaleaddmulti = NULL;
 
     /* Create content */
     content = (N_VectorContent_NrnSerialLD) malloc(sizeof(struct _N_VectorContent_NrnSerialLD));
@@ -213,6 +215,8 @@ N_Vector N_VCloneEmpty_NrnSerialLD(N_Vector w) {
     ops->nvinvtest = w->ops->nvinvtest;
     ops->nvconstrmask = w->ops->nvconstrmask;
     ops->nvminquotient = w->ops->nvminquotient;
+    ops->nvscalevectorarray = w->ops->nvscalevectorarray;
+    ops->nvscaleaddmulti = w->ops->nvscaleaddmulti;
 
     /* Create content */
     content = (N_VectorContent_NrnSerialLD) malloc(sizeof(struct _N_VectorContent_NrnSerialLD));
@@ -24,7 +24,10 @@
 #include "shared/sundialsmath.h"
 #include "shared/sundialstypes.h"
 #include "section.h"
-#include "nrnmutdec.h"
+#include "multicore.h"
+
+#include <algorithm>
+#include <vector>
 
 #define ZERO   RCONST(0.0)
 #define HALF   RCONST(0.5)
@@ -39,9 +42,6 @@
 #define mydebug2(a, b) /**/
 #endif
 
-#if NRN_ENABLE_THREADS
-static MUTDEC
-#endif
 /* argument passing between NrnThread and Serial */
 static N_Vector x_;
 static N_Vector y_;
@@ -51,8 +51,6 @@ static N_Vector id_;
 static realtype a_;
 static realtype b_;
 static realtype c_;
-static realtype retval;
-static booleantype bretval;
 #define xpass    x_ = x;
 #define ypass    y_ = y;
 #define zpass    z_ = z;
@@ -69,29 +67,72 @@ static booleantype bretval;
 #define aarg     a_
 #define barg     b_
 #define carg     c_
-#define lock     MUTLOCK
-#define unlock   MUTUNLOCK
-#define lockadd(arg) \
-    lock;            \
-    retval += arg;   \
-    unlock;
-#define locklongdadd(arg) lockadd(arg)
-#define lockmax(arg)    \
-    lock;               \
-    if (retval < arg) { \
-        retval = arg;   \
-    };                  \
-    unlock;
-#define lockmin(arg)    \
-    lock;               \
-    if (retval > arg) { \
-        retval = arg;   \
-    };                  \
-    unlock;
-#define lockfalse    \
-    lock;            \
-    bretval = FALSE; \
-    unlock;
+
+/* Per NrnThread results of the reductions. The caller combines them in
+   thread order after the join, so no lock is needed and the result does not
+   depend on which thread finished first. */
+struct alignas(64) partial_t {
+    realtype r;
+    booleantype b;
+};
+static std::vector<partial_t> partial_;
+
+static void partial_init(realtype r) {
+    partial_.assign(nrn_nthread, partial_t{r, TRUE});
+}
+static realtype partial_sum() {
+    realtype s = ZERO;
+    for (const auto& p: partial_) {
+        s += p.r;
+    }
+    return s;
+}
+static realtype partial_max() {
+    realtype m = partial_[0].r;
+    for (const auto& p: partial_) {
+        m = std::max(m, p.r);
+    }
+    return m;
+}
+static realtype partial_min() {
+    realtype m = partial_[0].r;
+    for (const auto& p: partial_) {
+        m = std::min(m, p.r);
+    }
+    return m;
+}
+static booleantype partial_and() {
+    for (const auto& p: partial_) {
+        if (!p.b) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/* Each operation on a vector longer than serial_length_ is a
+   nrn_multithread_job. Shorter ones are computed by the calling thread, one
+   subvector after another, as the fork and join of the workers costs more
+   than the arithmetic. */
+static long serial_length_ = 8192;
+
+long N_VSerialLength_NrnThread(long n) {
+    long old = serial_length_;
+    if (n >= 0) {
+        serial_length_ = n;
+    }
+    return old;
+}
+
+static void nv_job(N_Vector x, void* (*job)(NrnThread*)) {
+    if (NV_LENGTH_NT(x) <= serial_length_) {
+        for (int i = 0; i < nrn_nthread; ++i) {
+            (*job)(nrn_threads + i);
+        }
+    } else {
+        nrn_multithread_job(job);
+    }
+}
 
 /*
  * -----------------------------------------------------------------
@@ -109,10 +150,6 @@ N_Vector N_VNewEmpty_NrnThread(long int length, int nthread, long int* sizes) {
     N_Vector_Ops ops;
     N_VectorContent_NrnThread content;
 
-    if (!MUTCONSTRUCTED) {
-        MUTCONSTRUCT(1)
-    }
-
     /* Create vector */
     v = (N_Vector) malloc(sizeof *v);
     if (v == NULL)
@@ -149,6 +186,8 @@ N_Vector N_VNewEmpty_NrnThread(long int length, int nthread, long int* sizes) {
     ops->nvinvtest = N_VInvTest_NrnThread;
     ops->nvconstrmask = N_VConstrMask_NrnThread;
     ops->nvminquotient = N_VMinQuotient_NrnThread;
+    ops->nvscalevectorarray = N_VScaleVectorArray_NrnThread;
+    ops->nvscaleaddmulti = N_VScaleAddMulti_NrnThread;
 
     /* Create content */
     content = (N_VectorContent_NrnThread) malloc(sizeof(struct _N_VectorContent_NrnThread));
@@ -259,6 +298,8 @@ N_Vector N_VCloneEmpty_NrnThread(N_Vector w) {
     ops->nvinvtest = w->ops->nvinvtest;
     ops->nvconstrmask = w->ops->nvconstrmask;
     ops->nvminquotient = w->ops->nvminquotient;
+    ops->nvscalevectorarray = w->ops->nvscalevectorarray;
+    ops->nvscaleaddmulti = w->ops->nvscaleaddmulti;
 
     /* Create content */
     content = (N_VectorContent_NrnThread) malloc(sizeof(struct _N_VectorContent_NrnThread));
@@ -486,7 +527,7 @@ static void* vlinearsum(NrnThread* nt) {
     return nullptr;
 }
 void N_VLinearSum_NrnThread(realtype a, N_Vector x, realtype b, N_Vector y, N_Vector z) {
-    apass bpass xpass ypass zpass nrn_multithread_job(vlinearsum);
+    apass bpass xpass ypass zpass nv_job(x, vlinearsum);
     mydebug("vlinearsum\n");
     /*pr(z);*/
 }
@@ -497,7 +538,7 @@ static void* vconst(NrnThread* nt) {
     return nullptr;
 }
 void N_VConst_NrnThread(realtype c, N_Vector z) {
-    cpass zpass nrn_multithread_job(vconst);
+    cpass zpass nv_job(z, vconst);
     mydebug("vconst\n");
 }
 
@@ -507,7 +548,7 @@ static void* vprod(NrnThread* nt) {
     return nullptr;
 }
 void N_VProd_NrnThread(N_Vector x, N_Vector y, N_Vector z) {
-    xpass ypass zpass nrn_multithread_job(vprod);
+    xpass ypass zpass nv_job(x, vprod);
     mydebug("vprod\n");
 }
 
@@ -517,7 +558,7 @@ static void* vdiv(NrnThread* nt) {
     return nullptr;
 }
 void N_VDiv_NrnThread(N_Vector x, N_Vector y, N_Vector z) {
-    xpass ypass zpass nrn_multithread_job(vdiv);
+    xpass ypass zpass nv_job(x, vdiv);
     mydebug("vdiv\n");
 }
 
@@ -527,7 +568,7 @@ static void* vscale(NrnThread* nt) {
     return nullptr;
 }
 void N_VScale_NrnThread(realtype c, N_Vector x, N_Vector z) {
-    cpass xpass zpass nrn_multithread_job(vscale);
+    cpass xpass zpass nv_job(x, vscale);
     mydebug("vscale\n");
     /*pr(z);*/
 }
@@ -538,7 +579,7 @@ static void* vabs(NrnThread* nt) {
     return nullptr;
 }
 void N_VAbs_NrnThread(N_Vector x, N_Vector z) {
-    xpass zpass nrn_multithread_job(vabs);
+    xpass zpass nv_job(x, vabs);
     mydebug("vabs\n");
 }
 
@@ -548,7 +589,7 @@ static void* vinv(NrnThread* nt) {
     return nullptr;
 }
 void N_VInv_NrnThread(N_Vector x, N_Vector z) {
-    xpass zpass nrn_multithread_job(vinv);
+    xpass zpass nv_job(x, vinv);
     mydebug("vinv\n");
 }
 
@@ -558,7 +599,7 @@ static void* vaddconst(NrnThread* nt) {
     return nullptr;
 }
 void N_VAddConst_NrnThread(N_Vector x, realtype b, N_Vector z) {
-    bpass xpass zpass nrn_multithread_job(vaddconst);
+    bpass xpass zpass nv_job(x, vaddconst);
     mydebug("vaddconst\n");
 }
 
@@ -566,12 +607,13 @@ static void* vdotprod(NrnThread* nt) {
     realtype s;
     int i = nt->id;
     s = N_VDotProd_Serial(xarg(i), yarg(i));
-    lockadd(s);
+    partial_[i].r = s;
     return nullptr;
 }
 realtype N_VDotProd_NrnThread(N_Vector x, N_Vector y) {
-    retval = ZERO;
-    xpass ypass nrn_multithread_job(vdotprod);
+    partial_init(ZERO);
+    xpass ypass nv_job(x, vdotprod);
+    realtype retval = partial_sum();
     mydebug2("vdotprod %.20g\n", retval);
     return (retval);
 }
@@ -580,12 +622,13 @@ static void* vmaxnorm(NrnThread* nt) {
     realtype max;
     int i = nt->id;
     max = N_VMaxNorm_Serial(xarg(i));
-    lockmax(max);
+    partial_[i].r = max;
     return nullptr;
 }
 realtype N_VMaxNorm_NrnThread(N_Vector x) {
-    retval = ZERO;
-    xpass nrn_multithread_job(vmaxnorm);
+    partial_init(ZERO);
+    xpass nv_job(x, vmaxnorm);
+    realtype retval = partial_max();
     mydebug2("vmaxnorm %.20g\n", retval);
     return (retval);
 }
@@ -611,14 +654,15 @@ static void* vwrmsnorm(NrnThread* nt) {
     realtype s;
     int i = nt->id;
     s = vwrmsnorm_help(xarg(i), warg(i));
-    locklongdadd(s);
+    partial_[i].r = s;
     return nullptr;
 }
 realtype N_VWrmsNorm_NrnThread(N_Vector x, N_Vector w) {
     long int N;
     N = NV_LENGTH_NT(x);
-    retval = ZERO;
-    xpass wpass nrn_multithread_job(vwrmsnorm);
+    partial_init(ZERO);
+    xpass wpass nv_job(x, vwrmsnorm);
+    realtype retval = partial_sum();
     mydebug2("vwrmsnorm %.20g\n", RSqrt(retval / N));
     return (RSqrt(retval / N));
 }
@@ -645,14 +689,15 @@ static void* vwrmsnormmask(NrnThread* nt) {
     realtype s;
     int i = nt->id;
     s = vwrmsnormmask_help(xarg(i), warg(i), idarg(i));
-    lockadd(s);
+    partial_[i].r = s;
     return nullptr;
 }
 realtype N_VWrmsNormMask_NrnThread(N_Vector x, N_Vector w, N_Vector id) {
     long int N;
     N = NV_LENGTH_NT(x);
-    retval = ZERO;
-    xpass wpass idpass nrn_multithread_job(vwrmsnormmask);
+    partial_init(ZERO);
+    xpass wpass idpass nv_job(x, vwrmsnormmask);
+    realtype retval = partial_sum();
     mydebug2("vwrmsnormmask %.20g\n", RSqrt(retval / N));
     return (RSqrt(retval / N));
 }
@@ -662,13 +707,14 @@ static void* vmin(NrnThread* nt) {
     int i = nt->id;
     if (NV_LENGTH_S(xarg(i))) {
         min = N_VMin_Serial(xarg(i));
-        lockmin(min);
+        partial_[i].r = min;
     }
     return nullptr;
 }
 realtype N_VMin_NrnThread(N_Vector x) {
-    retval = BIG_REAL;
-    xpass nrn_multithread_job(vmin);
+    partial_init(BIG_REAL);
+    xpass nv_job(x, vmin);
+    realtype retval = partial_min();
     mydebug2("vmin %.20g\n", retval);
     return (retval);
 }
@@ -692,13 +738,14 @@ static void* vwl2norm(NrnThread* nt) {
     realtype sum;
     int i = nt->id;
     sum = N_VWL2Norm_helper(xarg(i), warg(i));
-    lockadd(sum);
+    partial_[i].r = sum;
     return nullptr;
 }
 realtype N_VWL2Norm_NrnThread(N_Vector x, N_Vector w) {
     long int N;
-    retval = ZERO;
-    xpass wpass nrn_multithread_job(vwl2norm);
+    partial_init(ZERO);
+    xpass wpass nv_job(x, vwl2norm);
+    realtype retval = partial_sum();
     N = NV_LENGTH_NT(x);
     mydebug2("vwl2norm %.20g\n", RSqrt(retval));
     return (RSqrt(retval));
@@ -708,12 +755,13 @@ static void* vl1norm(NrnThread* nt) {
     realtype sum;
     int i = nt->id;
     sum = N_VL1Norm_Serial(xarg(i));
-    lockadd(sum);
+    partial_[i].r = sum;
     return nullptr;
 }
 realtype N_VL1Norm_NrnThread(N_Vector x) {
-    retval = ZERO;
-    xpass nrn_multithread_job(vl1norm);
+    partial_init(ZERO);
+    xpass nv_job(x, vl1norm);
+    realtype retval = partial_sum();
     mydebug2("vl1norm %.20g\n", retval);
     return (retval);
 }
@@ -724,7 +772,7 @@ static void* v1mask(NrnThread* nt) {
     return nullptr;
 }
 void N_VOneMask_NrnThread(N_Vector x) {
-    xpass nrn_multithread_job(v1mask);
+    xpass nv_job(x, v1mask);
 }
 
 static void* vcompare(NrnThread* nt) {
@@ -733,7 +781,7 @@ static void* vcompare(NrnThread* nt) {
     return nullptr;
 }
 void N_VCompare_NrnThread(realtype c, N_Vector x, N_Vector z) {
-    cpass xpass zpass nrn_multithread_job(vcompare);
+    cpass xpass zpass nv_job(x, vcompare);
     mydebug("vcompare\n");
 }
 
@@ -742,13 +790,14 @@ static void* vinvtest(NrnThread* nt) {
     int i = nt->id;
     b = N_VInvTest_Serial(xarg(i), zarg(i));
     if (!b) {
-        lockfalse;
+        partial_[i].b = FALSE;
     }
     return nullptr;
 }
 booleantype N_VInvTest_NrnThread(N_Vector x, N_Vector z) {
-    bretval = TRUE;
-    xpass zpass nrn_multithread_job(vinvtest);
+    partial_init(ZERO);
+    xpass zpass nv_job(x, vinvtest);
+    booleantype bretval = partial_and();
     mydebug2("vinvtest %d\n", bretval);
     return (bretval);
 }
@@ -758,13 +807,14 @@ static void* vconstrmask(NrnThread* nt) {
     int i = nt->id;
     b = N_VConstrMask_Serial(yarg(i), xarg(i), zarg(i));
     if (!b) {
-        lockfalse;
+        partial_[i].b = FALSE;
     }
     return nullptr;
 }
 booleantype N_VConstrMask_NrnThread(N_Vector y, N_Vector x, N_Vector z) {
-    bretval = TRUE;
-    ypass xpass zpass nrn_multithread_job(vconstrmask);
+    partial_init(ZERO);
+    ypass xpass zpass nv_job(y, vconstrmask);
+    booleantype bretval = partial_and();
     mydebug2("vconstrmask %d\n", bretval);
     return (bretval);
 }
@@ -773,13 +823,55 @@ static void* vminquotient(NrnThread* nt) {
     realtype min;
     int i = nt->id;
     min = N_VMinQuotient_Serial(xarg(i), yarg(i));
-    lockmin(min);
+    partial_[i].r = min;
     return nullptr;
 }
 realtype N_VMinQuotient_NrnThread(N_Vector x, N_Vector y) /* num, denom */
 {
-    retval = BIG_REAL;
-    xpass ypass nrn_multithread_job(vconstrmask);
+    partial_init(BIG_REAL);
+    xpass ypass nv_job(x, vminquotient);
+    realtype retval = partial_min();
     mydebug2("vminquotient %.20g\n", retval);
     return (retval);
 }
+
+/* fused operations, one job for all the vectors */
+static int nvec_;
+static realtype* cvec_;
+static N_Vector* xvec_;
+static N_Vector* yvec_;
+static N_Vector* zvec_;
+
+static void* vscalevectorarray(NrnThread* nt) {
+    int i = nt->id;
+    for (int j = 0; j < nvec_; ++j) {
+        N_VScale_Serial(cvec_[j], NV_SUBVEC_NT(xvec_[j], i), NV_SUBVEC_NT(zvec_[j], i));
+    }
+    return nullptr;
+}
+void N_VScaleVectorArray_NrnThread(int nvec, realtype* c, N_Vector* X, N_Vector* Z) {
+    nvec_ = nvec;
+    cvec_ = c;
+    xvec_ = X;
+    zvec_ = Z;
+    nv_job(X[0], vscalevectorarray);
+    mydebug("vscalevectorarray\n");
+}
+
+static void* vscaleaddmulti(NrnThread* nt) {
+    int i = nt->id;
+    for (int j = 0; j < nvec_; ++j) {
+        N_VLinearSum_Serial(
+            cvec_[j], xarg(i), ONE, NV_SUBVEC_NT(yvec_[j], i), NV_SUBVEC_NT(zvec_[j], i));
+    }
+    return nullptr;
+}
+void N_VScaleAddMulti_NrnThread(int nvec, realtype* a, N_Vector x, N_Vector* Y, N_Vector* Z) {
+    nvec_ = nvec;
+    cvec_ = a;
+    x_ = x;
+    yvec_ = Y;
+    zvec_ = Z;
+    nv_job(x, vscaleaddmulti);
+    mydebug("vscaleaddmulti\n");
+}
@@ -150,6 +150,8 @@ N_Vector N_VNewEmpty_NrnThreadLD(long int length, int nthread, long int* sizes)
     ops->nvinvtest = N_VInvTest_NrnThreadLD;
     ops->nvconstrmask = N_VConstrMask_NrnThreadLD;
     ops->nvminquotient = N_VMinQuotient_NrnThreadLD;
+    ops->nvscalevectorarray = NULL;
+    ops->nvscaleaddmulti = NULL;
 
     /* Create content */
     content = (N_VectorContent_NrnThreadLD) malloc(sizeof(struct _N_VectorContent_NrnThreadLD));
@@ -260,6 +262,8 @@ N_Vector N_VCloneEmpty_NrnThreadLD(N_Vector w) {
     ops->nvinvtest = w->ops->nvinvtest;
     ops->nvconstrmask = w->ops->nvconstrmask;
     ops->nvminquotient = w->ops->nvminquotient;
+    ops->nvscalevectorarray = w->ops->nvscalevectorarray;
+    ops->nvscaleaddmulti = w->ops->nvscaleaddmulti;
 
     /* Create content */
     content = (N_VectorContent_NrnThreadLD) malloc(sizeof(struct _N_VectorContent_NrnThreadLD));
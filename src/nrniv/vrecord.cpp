@@ -7,8 +7,12 @@
 #include "nrnoc2iv.h"
 #include "ocobserv.h"
 #include "ivocvect.h"
+#include "ocptrvector.h"
 #include <stdio.h>
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "ocpointer.h"
 #include "vrecitem.h"
 #include "netcvode.h"
@@ -458,3 +462,207 @@ void VecPlayContinuousSave::savestate_read(FILE* f) {
     nrn_assert(fgets(buf, 100, f));
     nrn_assert(sscanf(buf, "%d %d %d\n", &last_index_, &discon_index_, &ubound_index_) == 3);
 }
+
+// PtrVector.record
+
+static ColumnRecord* column_record(OcPtrVector* pv) {
+    for (auto* cr: net_cvode_instance->column_record_) {
+        if (cr->pv_ == pv) {
+            return cr;
+        }
+    }
+    return nullptr;
+}
+
+void nrn_ptrvec_record_remove(OcPtrVector* pv) {
+    delete column_record(pv);
+}
+
+void nrn_ptrvec_record(OcPtrVector* pv, IvocVect* y, const char* fname, std::size_t chunk) {
+    nrn_ptrvec_record_remove(pv);
+    net_cvode_instance->column_record_.push_back(new ColumnRecord(pv, y, fname, chunk));
+}
+
+void nrn_ptrvec_record_resize(OcPtrVector* pv) {
+    if (auto* cr = column_record(pv)) {
+        cr->columns_changed();
+    }
+}
+
+void nrn_ptrvec_record_flush(OcPtrVector* pv) {
+    if (auto* cr = column_record(pv)) {
+        cr->commit();
+        cr->flush();
+    }
+}
+
+ColumnRecord::ColumnRecord(OcPtrVector* pv, IvocVect* y, const char* fname, std::size_t chunk)
+    : pv_{pv}
+    , y_{y}
+    , fname_{fname ? fname : ""}
+    , chunk_{chunk} {
+    ObjObservable::Attach(y_->obj_, this);
+}
+
+ColumnRecord::~ColumnRecord() {
+    commit();
+    flush();
+    if (f_) {
+        fclose(f_);
+    }
+    ObjObservable::Detach(y_->obj_, this);
+    auto& crl = net_cvode_instance->column_record_;
+    crl.erase(std::remove(crl.begin(), crl.end(), this), crl.end());
+}
+
+void ColumnRecord::disconnect(Observable*) {
+    delete this;
+}
+
+void ColumnRecord::record_init() {
+    if (net_cvode_instance->is_local()) {
+        hoc_execerror("PtrVector.record", "not allowed with the local variable time step method");
+    }
+    auto const& pd = pv_->pd_;
+    ncol_ = pd.size();
+    cols_.assign(nrn_nthread, {});
+    staged_.assign(nrn_nthread, {});
+    nstaged_.assign(nrn_nthread, 0);
+    if (nrn_nthread == 1) {
+        for (std::size_t i = 0; i < ncol_; ++i) {
+            cols_[0].push_back(i);
+        }
+    } else {
+        // One pass over the model instead of NetCvode::owned_by_thread per
+        // pointer. Pointers that belong to no thread, e.g. hoc variables,
+        // GLOBALs or ARTIFICIAL_CELL variables, are read by thread 0 when it
+        // records, while the other threads may still be in their step.
+        std::unordered_map<double const*, int> owner;
+        for (int it = 0; it < nrn_nthread; ++it) {
+            NrnThread& nt = nrn_threads[it];
+            for (int in = 0; in < nt.end; ++in) {
+                Node* nd = nt._v_node[in];
+                owner[static_cast<double const*>(nd->v_handle())] = it;
+                for (Prop* p = nd->prop; p; p = p->next) {
+                    for (int i = 0; i < p->param_num_vars(); ++i) {
+                        for (int j = 0; j < p->param_array_dimension(i); ++j) {
+                            owner[&p->param(i, j)] = it;
+                        }
+                    }
+                }
+                if (nd->extnode) {
+                    for (int j = 0; j < nlayer; ++j) {
+                        owner[nd->extnode->v + j] = it;
+                    }
+                }
+            }
+        }
+        for (std::size_t i = 0; i < ncol_; ++i) {
+            auto const it = owner.find(static_cast<double const*>(pd[i]));
+            cols_[it == owner.end() ? 0 : it->second].push_back(i);
+        }
+    }
+    y_->vec().clear();
+    if (chunk_) {
+        y_->grow_capacity(chunk_ * ncol_);
+    }
+    if (!fname_.empty()) {
+        if (f_) {
+            fclose(f_);
+        }
+        f_ = fopen(fname_.c_str(), "wb");
+        if (!f_) {
+            hoc_execerror("PtrVector.record could not open", fname_.c_str());
+        }
+    }
+}
+
+// Append a row to y_. If a file is being written, the full chunk is written
+// first.
+double* ColumnRecord::new_row() {
+    if (f_ && chunk_ && nrow() >= chunk_) {
+        flush();
+    }
+    auto& v = y_->vec();
+    std::size_t const n = v.size() + ncol_;
+    y_->grow_capacity(n);
+    v.resize(n);
+    return v.data() + n - ncol_;
+}
+
+// The PtrVector was resized. The columns captured by record_init may no
+// longer exist, so keep the rows so far and stop recording until the next
+// record_init.
+void ColumnRecord::columns_changed() {
+    commit();
+    ncol_ = 0;
+    cols_.clear();
+    staged_.clear();
+    nstaged_.clear();
+}
+
+void ColumnRecord::continuous(NrnThread& nt) {
+    if (ncol_ == 0 || cols_.size() != std::size_t(nrn_nthread)) {
+        return;  // no record_init since PtrVector.record or nthread changed
+    }
+    if (nrn_nthread == 1) {
+        continuous();
+        return;
+    }
+    auto const& pd = pv_->pd_;
+    auto const& cols = cols_[nt.id];
+    auto& s = staged_[nt.id];
+    std::size_t const k = s.size();
+    s.resize(k + cols.size());
+    for (std::size_t i = 0; i < cols.size(); ++i) {
+        s[k + i] = *pd[cols[i]];
+    }
+    ++nstaged_[nt.id];
+}
+
+void ColumnRecord::continuous() {
+    if (ncol_ == 0) {
+        return;
+    }
+    commit();
+    auto const& pd = pv_->pd_;
+    double* row = new_row();
+    for (std::size_t i = 0; i < ncol_; ++i) {
+        row[i] = *pd[i];
+    }
+}
+
+void ColumnRecord::commit() {
+    if (nstaged_.empty() || ncol_ == 0) {
+        return;
+    }
+    std::size_t const n = *std::min_element(nstaged_.begin(), nstaged_.end());
+    if (n == 0) {
+        return;
+    }
+    for (std::size_t r = 0; r < n; ++r) {
+        double* row = new_row();
+        for (std::size_t it = 0; it < cols_.size(); ++it) {
+            auto const& cols = cols_[it];
+            double const* s = staged_[it].data() + r * cols.size();
+            for (std::size_t i = 0; i < cols.size(); ++i) {
+                row[cols[i]] = s[i];
+            }
+        }
+    }
+    for (std::size_t it = 0; it < cols_.size(); ++it) {
+        auto& s = staged_[it];
+        s.erase(s.begin(), s.begin() + n * cols_[it].size());
+        nstaged_[it] -= n;
+    }
+}
+
+void ColumnRecord::flush() {
+    if (f_ && y_->size()) {
+        if (fwrite(y_->data(), sizeof(double), y_->size(), f_) != y_->size()) {
+            hoc_execerror("PtrVector.record could not write", fname_.c_str());
+        }
+        fflush(f_);
+        y_->vec().clear();
+    }
+}
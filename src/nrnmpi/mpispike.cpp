@@ -167,6 +167,94 @@ int nrnmpi_spike_exchange(int* ovfl,
     return n;
 }
 
+// Non-blocking variant of nrnmpi_spike_exchange (nrn_spikebuf_size == 0) so
+// that the exchange can overlap with computation. The counts are gathered
+// with MPI_Iallgather and, once they have arrived, the spikes with
+// MPI_Iallgatherv. The caller must not touch the arguments of
+// nrnmpi_spike_exchange_start until nrnmpi_spike_exchange_finish returns the
+// number of spikes in *spikein. nrnmpi_spike_exchange_advance starts the
+// second stage, without blocking, if the first is complete.
+static MPI_Request ovl_request = MPI_REQUEST_NULL;
+static int ovl_stage;  // 0 idle, 1 counts in flight, 2 spikes in flight
+static int ovl_n;
+static int* ovl_nout;
+static int* ovl_nin;
+static int* ovl_displs;
+static NRNMPI_Spike* ovl_spikeout;
+static NRNMPI_Spike** ovl_spikein;
+static int* ovl_icapacity;
+
+void nrnmpi_spike_exchange_start(int* nout,
+                                 int* nin,
+                                 NRNMPI_Spike* spikeout,
+                                 NRNMPI_Spike** spikein,
+                                 int* icapacity) {
+    assert(ovl_stage == 0);
+    if (!ovl_displs) {
+        ovl_displs = (int*) hoc_Emalloc(nrnmpi_numprocs * sizeof(int));
+        hoc_malchk();
+    }
+    ovl_nout = nout;
+    ovl_nin = nin;
+    ovl_spikeout = spikeout;
+    ovl_spikein = spikein;
+    ovl_icapacity = icapacity;
+    nrnbbs_context_wait();
+    MPI_Iallgather(nout, 1, MPI_INT, nin, 1, MPI_INT, nrnmpi_comm, &ovl_request);
+    ovl_stage = 1;
+}
+
+static void ovl_start_spikes() {
+    int n = 0;
+    for (int i = 0; i < nrnmpi_numprocs; ++i) {
+        ovl_displs[i] = n;
+        n += ovl_nin[i];
+    }
+    ovl_n = n;
+    if (n) {
+        if (*ovl_icapacity < n) {
+            *ovl_icapacity = n + 10;
+            free(*ovl_spikein);
+            *ovl_spikein = (NRNMPI_Spike*) hoc_Emalloc(*ovl_icapacity * sizeof(NRNMPI_Spike));
+            hoc_malchk();
+        }
+        MPI_Iallgatherv(ovl_spikeout,
+                        *ovl_nout,
+                        spike_type,
+                        *ovl_spikein,
+                        ovl_nin,
+                        ovl_displs,
+                        spike_type,
+                        nrnmpi_comm,
+                        &ovl_request);
+    }
+    ovl_stage = 2;
+}
+
+void nrnmpi_spike_exchange_advance() {
+    int flag = 0;
+    if (ovl_stage == 1) {
+        MPI_Test(&ovl_request, &flag, MPI_STATUS_IGNORE);
+        if (flag) {
+            ovl_start_spikes();
+        }
+    } else if (ovl_stage == 2) {
+        MPI_Test(&ovl_request, &flag, MPI_STATUS_IGNORE);
+    }
+}
+
+int nrnmpi_spike_exchange_finish() {
+    if (ovl_stage == 1) {
+        MPI_Wait(&ovl_request, MPI_STATUS_IGNORE);
+        ovl_start_spikes();
+    }
+    if (ovl_stage == 2) {
+        MPI_Wait(&ovl_request, MPI_STATUS_IGNORE);
+    }
+    ovl_stage = 0;
+    return ovl_n;
+}
+
 /*
 The compressed spike format is restricted to the fixed step method and is
 a sequence of unsigned char.
@@ -715,4 +803,71 @@ int nrnmpi_multisend_conserve(int nsend, int nrecv) {
     return tcnts[1];
 }
 
+// Distributed graph topology for MPI_Neighbor_alltoallv spike exchange.
+// srcs are the ranks this rank receives spikes from and dests are the ranks
+// this rank sends spikes to, in the order of the counts of
+// nrnmpi_neighbor_exchange.
+static MPI_Comm neighbor_comm = MPI_COMM_NULL;
+static int neighbor_nsrc;
+static int* neighbor_rcnt;
+static int* neighbor_rdispl;
+
+void nrnmpi_neighbor_comm(int nsrc, int* srcs, int ndest, int* dests) {
+    if (neighbor_comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&neighbor_comm);
+        neighbor_comm = MPI_COMM_NULL;
+        free(neighbor_rcnt);
+        free(neighbor_rdispl);
+    }
+    // reorder = 0, the neighbor ranks are ranks in nrnmpi_comm
+    MPI_Dist_graph_create_adjacent(nrnmpi_comm,
+                                   nsrc,
+                                   srcs,
+                                   MPI_UNWEIGHTED,
+                                   ndest,
+                                   dests,
+                                   MPI_UNWEIGHTED,
+                                   MPI_INFO_NULL,
+                                   0,
+                                   &neighbor_comm);
+    neighbor_nsrc = nsrc;
+    neighbor_rcnt = (int*) hoc_Emalloc((nsrc + 1) * sizeof(int));
+    hoc_malchk();
+    neighbor_rdispl = (int*) hoc_Emalloc((nsrc + 1) * sizeof(int));
+    hoc_malchk();
+}
+
+// scnt[i] spikes starting at spikeout[sdispl[i]] go to dests[i].
+// Returns the number of spikes received into *spikein, which is enlarged
+// as needed.
+int nrnmpi_neighbor_exchange(NRNMPI_Spike* spikeout,
+                             int* scnt,
+                             int* sdispl,
+                             NRNMPI_Spike** spikein,
+                             int* icapacity) {
+    nrnbbs_context_wait();
+    MPI_Neighbor_alltoall(scnt, 1, MPI_INT, neighbor_rcnt, 1, MPI_INT, neighbor_comm);
+    int n = 0;
+    for (int i = 0; i < neighbor_nsrc; ++i) {
+        neighbor_rdispl[i] = n;
+        n += neighbor_rcnt[i];
+    }
+    if (*icapacity < n) {
+        *icapacity = n + 10;
+        free(*spikein);
+        *spikein = (NRNMPI_Spike*) hoc_Emalloc(*icapacity * sizeof(NRNMPI_Spike));
+        hoc_malchk();
+    }
+    MPI_Neighbor_alltoallv(spikeout,
+                           scnt,
+                           sdispl,
+                           spike_type,
+                           *spikein,
+                           neighbor_rcnt,
+                           neighbor_rdispl,
+                           spike_type,
+                           neighbor_comm);
+    return n;
+}
+
 #endif /*NRNMPI*/
@@ -78,6 +78,9 @@ extern void nrnmpi_print_memory_stats(neuron::container::MemoryStats const& stat
 extern void nrnmpi_spike_initialize();
 extern int nrnmpi_spike_exchange(int* ovfl, int* nout, int* nin, NRNMPI_Spike* spikeout, NRNMPI_Spike** spikein, int* icapacity_);
 extern int nrnmpi_spike_exchange_compressed(int localgid_size, int ag_send_size, int ag_send_nspike, int* ovfl_capacity, int* ovfl, unsigned char* spfixout, unsigned char* spfixin, unsigned char** spfixin_ovfl, int* nin_);
+extern void nrnmpi_spike_exchange_start(int* nout, int* nin, NRNMPI_Spike* spikeout, NRNMPI_Spike** spikein, int* icapacity);
+extern void nrnmpi_spike_exchange_advance();
+extern int nrnmpi_spike_exchange_finish();
 extern double nrnmpi_mindelay(double maxdel);
 extern int nrnmpi_int_allmax(int i);
 extern void nrnmpi_int_gather(int* s, int* r, int cnt, int root);
@@ -127,6 +130,8 @@ extern void nrnmpi_multisend_comm();
 extern void nrnmpi_multisend_multisend(NRNMPI_Spike* spk, int n, int* hosts);
 extern int nrnmpi_multisend_single_advance(NRNMPI_Spike* spk);
 extern int nrnmpi_multisend_conserve(int nsend, int nrecv);
+extern void nrnmpi_neighbor_comm(int nsrc, int* srcs, int ndest, int* dests);
+extern int nrnmpi_neighbor_exchange(NRNMPI_Spike* spikeout, int* scnt, int* sdispl, NRNMPI_Spike** spikein, int* icapacity);
 #endif
 // clang-format on
 }
@@ -13,8 +13,10 @@
 #include "utils/profile/profiler_interface.h"
 #include "nonvintblock.h"
 #include "nrncvode.h"
+#include "nrn_phase_time.h"
 #include "spmatrix.h"
 
+#include <cstring>
 #include <vector>
 
 /*
@@ -55,6 +57,7 @@ static void nrn_fixed_step_thread(neuron::model_sorted_token const&, NrnThread&)
 static void nrn_fixed_step_group_thread(neuron::model_sorted_token const&, NrnThread&);
 extern void nrn_solve(NrnThread*);
 static void nonvint(neuron::model_sorted_token const&, NrnThread&);
+static void nrn_fixed_step_after_nonvint_block(neuron::model_sorted_token const&, NrnThread&);
 extern void nrncvode_set_t(double t);
 
 static void* nrn_ms_treeset_through_triang(NrnThread*);
@@ -81,6 +84,119 @@ extern double hoc_epsilon;
 #define CTADD   /**/
 #endif
 
+bool nrn_phase_time_on_;
+
+namespace {
+// Each thread accumulates into whole 64 byte cache lines of its own.
+struct alignas(64) phase_line_t {
+    double x[8];
+};
+static_assert(sizeof(phase_line_t) == 64);
+static_assert(NRN_PHASE_COUNT <= 8);
+std::vector<phase_line_t> phase_time_;       // one line per thread
+std::vector<phase_line_t> phase_mech_time_;  // phase_mech_row_ doubles per thread
+int phase_time_nthread_;
+int phase_mech_n_;
+std::size_t phase_mech_row_;  // 2 * phase_mech_n_ rounded up to whole lines
+
+double* phase_mech_row(int tid) {
+    return reinterpret_cast<double*>(phase_mech_time_.data()) + phase_mech_row_ * tid;
+}
+
+const char* phase_names_[NRN_PHASE_COUNT] = {"deliver-events",
+                                             "setup-tree-matrix",
+                                             "matrix-solver",
+                                             "second-order-cur",
+                                             "update",
+                                             "state-update",
+                                             "record"};
+
+void phase_time_alloc() {
+    phase_time_nthread_ = nrn_nthread;
+    phase_mech_n_ = n_memb_func;
+    phase_mech_row_ = (std::size_t(2) * phase_mech_n_ + 7) / 8 * 8;
+    phase_time_.assign(phase_time_nthread_, phase_line_t{});
+    phase_mech_time_.assign(phase_mech_row_ / 8 * phase_time_nthread_, phase_line_t{});
+}
+
+// Called from the main thread before a step. The thread or mechanism count
+// may have changed since nrn_phase_time_enable.
+void phase_time_check() {
+    if (nrn_phase_time_on_ &&
+        (phase_time_nthread_ != nrn_nthread || phase_mech_n_ != n_memb_func)) {
+        phase_time_alloc();
+    }
+}
+
+// Accumulates the lifetime of the object into phase of nt.
+struct phase_timer {
+    phase_timer(NrnThread& nt, NrnPhase phase)
+        : m_tid{nt.id}
+        , m_phase{phase}
+        , m_w{nrn_phase_time_on_ ? nrnmpi_wtime() : 0.0} {}
+    ~phase_timer() {
+        if (nrn_phase_time_on_) {
+            nrn_phase_time_add(m_tid, m_phase, nrnmpi_wtime() - m_w);
+        }
+    }
+    int m_tid;
+    NrnPhase m_phase;
+    double m_w;
+};
+}  // namespace
+
+void nrn_phase_time_enable(bool on) {
+    nrn_phase_time_on_ = on;
+    if (on) {
+        phase_time_alloc();
+    } else {
+        phase_time_.clear();
+        phase_mech_time_.clear();
+        phase_time_nthread_ = 0;
+        phase_mech_n_ = 0;
+        phase_mech_row_ = 0;
+    }
+}
+
+const char* nrn_phase_name(int phase) {
+    return (phase >= 0 && phase < NRN_PHASE_COUNT) ? phase_names_[phase] : nullptr;
+}
+
+int nrn_phase_lookup(const char* name) {
+    for (int i = 0; i < NRN_PHASE_COUNT; ++i) {
+        if (strcmp(name, phase_names_[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+double nrn_phase_time(int tid, int phase) {
+    if (tid < 0 || tid >= phase_time_nthread_ || phase < 0 || phase >= NRN_PHASE_COUNT) {
+        return 0.0;
+    }
+    return phase_time_[tid].x[phase];
+}
+
+void nrn_phase_time_add(int tid, int phase, double dt) {
+    if (tid < phase_time_nthread_) {
+        phase_time_[tid].x[phase] += dt;
+    }
+}
+
+double nrn_phase_mech_time(int tid, int type, bool state) {
+    if (tid < 0 || tid >= phase_time_nthread_ || type < 0 || type >= phase_mech_n_) {
+        return 0.0;
+    }
+    return phase_mech_row(tid)[type * 2 + state];
+}
+
+void nrn_phase_mech_time_add(int tid, int type, bool state, double dt) {
+    if (tid < phase_time_nthread_ && type < phase_mech_n_) {
+        phase_mech_row(tid)[type * 2 + state] += dt;
+    }
+}
+
 #define ELIMINATE_T_ROUNDOFF 0
 #if ELIMINATE_T_ROUNDOFF
 /* in order to simplify and as much as possible avoid the handling
@@ -321,11 +437,32 @@ void nrn_daspk_init_step(double tt, double dteps, int upd) {
     nrn_thread_table_check(sorted_token);
 }
 
+/*
+With more than one NrnThread the nonvint block (e.g. rxd) is solved once, by
+the main thread between two thread jobs, instead of by each thread within
+nonvint. The block works on all threads' data and, outside of a job, its
+nrn_multitask has the worker threads.
+*/
+static bool nonvint_block_split() {
+    return nrn_nonvint_block && nrn_nthread > 1;
+}
+
+static void nonvint_block_between_jobs(neuron::model_sorted_token const& cache_token) {
+    if (nonvint_block_split()) {
+        {
+            phase_timer pt(nrn_threads[0], NRN_PHASE_STATE_UPDATE);
+            nrn_nonvint_block_fixed_step_solve(0);
+        }
+        nrn_multithread_job(cache_token, nrn_fixed_step_after_nonvint_block);
+    }
+}
+
 void nrn_fixed_step(neuron::model_sorted_token const& cache_token) {
     nrn::Instrumentor::phase p_timestep("timestep");
 #if ELIMINATE_T_ROUNDOFF
     nrn_chk_ndt();
 #endif
+    phase_time_check();
     if (t != nrn_threads->_t) {
         dt2thread(-1.);
     } else {
@@ -349,6 +486,7 @@ void nrn_fixed_step(neuron::model_sorted_token const& cache_token) {
             nrn_multithread_job(cache_token, nrn_fixed_step_lastpart);
         }
         //}
+        nonvint_block_between_jobs(cache_token);
     } else {
         nrn_multithread_job(cache_token, nrn_fixed_step_thread);
         /* if there is no nrnthread_v_transfer then there cannot be
@@ -362,8 +500,10 @@ void nrn_fixed_step(neuron::model_sorted_token const& cache_token) {
             }
             nrn_multithread_job(cache_token, nrn_fixed_step_lastpart);
         }
+        nonvint_block_between_jobs(cache_token);
     }
     t = nrn_threads[0]._t;
+    nrn_record_commit();
     if (nrn_allthread_handle) {
         (*nrn_allthread_handle)();
     }
@@ -381,6 +521,17 @@ void nrn_fixed_step_group(neuron::model_sorted_token const& cache_token, int n)
 #if ELIMINATE_T_ROUNDOFF
     nrn_chk_ndt();
 #endif
+    if (nonvint_block_split()) {
+        // a step group job cannot stop for the nonvint block
+        for (i = 0; i < n; ++i) {
+            nrn_fixed_step(cache_token);
+            if (stoprun) {
+                break;
+            }
+        }
+        return;
+    }
+    phase_time_check();
     dt2thread(dt);
     nrn_thread_table_check(cache_token);
     if (nrn_multisplit_setup_) {
@@ -411,6 +562,7 @@ void nrn_fixed_step_group(neuron::model_sorted_token const& cache_token, int n)
             nrn_multithread_job(nrn_ms_reduce_solve);
             nrn_multithread_job(nrn_ms_bksub);
         }
+        nrn_record_commit();
         if (nrn_allthread_handle) {
             (*nrn_allthread_handle)();
         }
@@ -421,6 +573,7 @@ void nrn_fixed_step_group(neuron::model_sorted_token const& cache_token, int n)
         while (step_group_end < step_group_n) {
             /*printf("step_group_end=%d step_group_n=%d\n", step_group_end, step_group_n);*/
             nrn_multithread_job(cache_token, nrn_fixed_step_group_thread);
+            nrn_record_commit();
             if (nrn_allthread_handle) {
                 (*nrn_allthread_handle)();
             }
@@ -458,6 +611,7 @@ static void nrn_fixed_step_thread(neuron::model_sorted_token const& cache_token,
     auto* const nth = &nt;
     {
         nrn::Instrumentor::phase p("deliver-events");
+        phase_timer pt(nt, NRN_PHASE_DELIVER_EVENTS);
         deliver_net_events(nth);
     }
 
@@ -470,9 +624,13 @@ static void nrn_fixed_step_thread(neuron::model_sorted_token const& cache_token,
     nt._t += .5 * nt._dt;
 #endif
     fixed_play_continuous(nth);
-    setup_tree_matrix(cache_token, nt);
+    {
+        phase_timer pt(nt, NRN_PHASE_SETUP_TREE_MATRIX);
+        setup_tree_matrix(cache_token, nt);
+    }
     {
         nrn::Instrumentor::phase p("matrix-solver");
+        phase_timer pt(nt, NRN_PHASE_MATRIX_SOLVER);
         if (neuron::interleave_permute_type) {
             neuron::solve_interleaved(nt.id);
         } else {
@@ -481,10 +639,12 @@ static void nrn_fixed_step_thread(neuron::model_sorted_token const& cache_token,
     }
     {
         nrn::Instrumentor::phase p("second-order-cur");
+        phase_timer pt(nt, NRN_PHASE_SECOND_ORDER_CUR);
         second_order_cur(nth);
     }
     {
         nrn::Instrumentor::phase p("update");
+        phase_timer pt(nt, NRN_PHASE_UPDATE);
         nrn_update_voltage(cache_token, *nth);
     }
     CTADD;
@@ -510,12 +670,32 @@ void nrn_fixed_step_lastpart(neuron::model_sorted_token const& cache_token, NrnT
 #endif
     fixed_play_continuous(nth);
     nrn_extra_scatter_gather(0, nth->id);
-    nonvint(cache_token, nt);
-    nrn_ba(cache_token, nt, AFTER_SOLVE);
-    fixed_record_continuous(cache_token, nt);
+    {
+        phase_timer pt(nt, NRN_PHASE_STATE_UPDATE);
+        nonvint(cache_token, nt);
+    }
+    CTADD;
+    if (!nonvint_block_split()) {
+        nrn_fixed_step_after_nonvint_block(cache_token, nt);
+    }
+}
+
+static void nrn_fixed_step_after_nonvint_block(neuron::model_sorted_token const& cache_token,
+                                               NrnThread& nt) {
+    auto* const nth = &nt;
+    CTBEGIN;
+    {
+        phase_timer pt(nt, NRN_PHASE_STATE_UPDATE);
+        nrn_ba(cache_token, nt, AFTER_SOLVE);
+    }
+    {
+        phase_timer pt(nt, NRN_PHASE_RECORD);
+        fixed_record_continuous(cache_token, nt);
+    }
     CTADD;
     {
         nrn::Instrumentor::phase p("deliver-events");
+        phase_timer pt(nt, NRN_PHASE_DELIVER_EVENTS);
         nrn_deliver_events(nth); /* up to but not past texit */
     }
 }
@@ -523,7 +703,10 @@ void nrn_fixed_step_lastpart(neuron::model_sorted_token const& cache_token, NrnT
 /* nrn_fixed_step_thread is split into three pieces */
 
 void* nrn_ms_treeset_through_triang(NrnThread* nth) {
-    deliver_net_events(nth);
+    {
+        phase_timer pt(*nth, NRN_PHASE_DELIVER_EVENTS);
+        deliver_net_events(nth);
+    }
     CTBEGIN;
     nrn_random_play();
 #if ELIMINATE_T_ROUNDOFF
@@ -533,8 +716,14 @@ void* nrn_ms_treeset_through_triang(NrnThread* nth) {
     nth->_t += .5 * nth->_dt;
 #endif
     fixed_play_continuous(nth);
-    setup_tree_matrix(nrn_ensure_model_data_are_sorted(), *nth);
-    nrn_multisplit_triang(nth);
+    {
+        phase_timer pt(*nth, NRN_PHASE_SETUP_TREE_MATRIX);
+        setup_tree_matrix(nrn_ensure_model_data_are_sorted(), *nth);
+    }
+    {
+        phase_timer pt(*nth, NRN_PHASE_MATRIX_SOLVER);
+        nrn_multisplit_triang(nth);
+    }
     CTADD;
     return nullptr;
 }
@@ -544,10 +733,19 @@ void* nrn_ms_reduce_solve(NrnThread* nth) {
 }
 void* nrn_ms_bksub(NrnThread* nth) {
     CTBEGIN;
-    nrn_multisplit_bksub(nth);
-    second_order_cur(nth);
+    {
+        phase_timer pt(*nth, NRN_PHASE_MATRIX_SOLVER);
+        nrn_multisplit_bksub(nth);
+    }
+    {
+        phase_timer pt(*nth, NRN_PHASE_SECOND_ORDER_CUR);
+        second_order_cur(nth);
+    }
     auto const cache_token = nrn_ensure_model_data_are_sorted();
-    nrn_update_voltage(cache_token, *nth);
+    {
+        phase_timer pt(*nth, NRN_PHASE_UPDATE);
+        nrn_update_voltage(cache_token, *nth);
+    }
     CTADD;
     /* see above comment in nrn_fixed_step_thread */
     if (!nrnthread_v_transfer_) {
@@ -741,7 +939,8 @@ static void nonvint(neuron::model_sorted_token const& sorted_token, NrnThread& n
         nrnthread_v_transfer_(&nt);
     }
     nrn::Instrumentor::phase_begin("state-update");
-    bool const measure{nt.id == 0 && nrn_mech_wtime_};
+    bool const measure_mech_wtime{nt.id == 0 && nrn_mech_wtime_};
+    bool const measure{measure_mech_wtime || nrn_phase_time_on_};
     errno = 0;
     for (auto* tml = nt.tml; tml; tml = tml->next) {
         if (memb_func[tml->index].state) {
@@ -752,7 +951,13 @@ static void nonvint(neuron::model_sorted_token const& sorted_token, NrnThread& n
             memb_func[tml->index].state(sorted_token, &nt, tml->ml, tml->index);
             nrn::Instrumentor::phase_end(mechname.c_str());
             if (measure) {
-                nrn_mech_wtime_[tml->index] += nrnmpi_wtime() - w;
+                auto const elapsed = nrnmpi_wtime() - w;
+                if (measure_mech_wtime) {
+                    nrn_mech_wtime_[tml->index] += elapsed;
+                }
+                if (nrn_phase_time_on_) {
+                    nrn_phase_mech_time_add(nt.id, tml->index, true, elapsed);
+                }
             }
             if (errno && nrn_errno_check(0)) {
                 hoc_warning("errno set during calculation of states", nullptr);
@@ -760,7 +965,9 @@ static void nonvint(neuron::model_sorted_token const& sorted_token, NrnThread& n
         }
     }
     long_difus_solve(sorted_token, 0, nt); /* if any longitudinal diffusion */
-    nrn_nonvint_block_fixed_step_solve(nt.id);
+    if (!nonvint_block_split()) {
+        nrn_nonvint_block_fixed_step_solve(nt.id);
+    }
     nrn::Instrumentor::phase_end("state-update");
 }
 
@@ -785,6 +992,7 @@ void frecord_init(void) { /* useful when changing states after an finitialize()
         for (i = 0; i < nrn_nthread; ++i) {
             fixed_record_continuous(nrn_ensure_model_data_are_sorted(), nrn_threads[i]);
         }
+        nrn_record_commit();
     }
     hoc_retpushx(1.);
 }
@@ -922,6 +1130,7 @@ void nrn_finitialize(int setv, double v) {
         for (i = 0; i < nrn_nthread; ++i) {
             fixed_record_continuous(sorted_token, nrn_threads[i]);
         }
+        nrn_record_commit();
     }
     for (i = 0; i < nrn_nthread; ++i) {
         nrn_deliver_events(nrn_threads + i); /* The record events at t=0 */
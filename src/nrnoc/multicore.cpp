@@ -39,6 +39,8 @@ the handling of v_structure_change as long as possible.
 
 #include "nmodlmutex.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <condition_variable>
 #include <mutex>
@@ -71,11 +73,63 @@ void nrn_mk_table_check();
 static std::vector<std::pair<int, NrnThreadMembList*>> table_check_;
 static int allow_busywait_;
 
-static void* nulljob(NrnThread* nt) {
-    return nullptr;
-}
+static void nulltask(void*, std::size_t) {}
 
 int nrn_inthread_;
+// NrnThread jobs are executed by the worker threads.
+static bool thread_parallel_;
+// Minimum number of participants in nrn_multitask.
+static std::size_t multitask_nworker_{1};
+static std::size_t multitask_max_nparticipant_{0};
+
+// id of the NrnThread whose job the calling system thread is executing.
+// 0 outside of jobs.
+static thread_local int executing_thread_id_{0};
+
+int nrn_executing_thread_id() {
+    return executing_thread_id_;
+}
+
+// Dynamic scheduling. When dynamic_nworker_ > 0 there are fewer worker
+// threads than NrnThread and every participant in a nrn_multithread_job
+// repeatedly claims the next unprocessed NrnThread. Which system thread
+// computes a given NrnThread changes from job to job, but each NrnThread is
+// still computed by exactly one of them so results do not change.
+static int dynamic_request_;  // as requested by nrn_thread_dynamic
+static int dynamic_nworker_;  // in effect, 0 means one worker per NrnThread
+static std::atomic<int> dynamic_next_;
+
+static void update_dynamic_nworker() {
+    dynamic_nworker_ = (dynamic_request_ > 0 && dynamic_request_ < nrn_nthread) ? dynamic_request_
+                                                                                : 0;
+}
+
+template <typename F>
+static void run_claimed_threads(F&& f) {
+    for (int i; (i = dynamic_next_.fetch_add(1, std::memory_order_relaxed)) < nrn_nthread;) {
+        executing_thread_id_ = i;
+        f(nrn_threads[i]);
+    }
+    executing_thread_id_ = 0;
+}
+
+// A nrn_multitask in progress. Each participant claims the next task.
+struct task_batch_t {
+    void (*task)(void*, std::size_t);
+    void* data;
+    std::size_t ntask;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> nparticipant{0};
+    void run() {
+        std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+        if (i < ntask) {
+            nparticipant.fetch_add(1, std::memory_order_relaxed);
+        }
+        for (; i < ntask; i = next.fetch_add(1, std::memory_order_relaxed)) {
+            task(data, i);
+        }
+    }
+};
 
 namespace nrn {
 std::unique_ptr<std::mutex> nmodlmutex;
@@ -95,7 +149,8 @@ struct worker_conf_t {
     /* for nrn_solve etc.*/
     std::variant<std::monostate,
                  worker_job_t,
-                 std::pair<worker_job_with_token_t, neuron::model_sorted_token const*>>
+                 std::pair<worker_job_with_token_t, neuron::model_sorted_token const*>,
+                 task_batch_t*>
         job{};
     std::size_t thread_id{};
     worker_flag flag{worker_flag::wait};
@@ -111,13 +166,27 @@ struct worker_kernel {
         throw std::runtime_error("worker_kernel");
     }
     void operator()(worker_job_t job) const {
+        if (dynamic_nworker_) {
+            run_claimed_threads([job](NrnThread& nt) { job(&nt); });
+            return;
+        }
+        executing_thread_id_ = static_cast<int>(m_thread_id);
         job(nrn_threads + m_thread_id);
     }
     void operator()(
         std::pair<worker_job_with_token_t, neuron::model_sorted_token const*> const& pair) const {
         auto const& [job, token_ptr] = pair;
+        if (dynamic_nworker_) {
+            run_claimed_threads([job, token_ptr](NrnThread& nt) { job(*token_ptr, nt); });
+            return;
+        }
+        executing_thread_id_ = static_cast<int>(m_thread_id);
         job(*token_ptr, nrn_threads[m_thread_id]);
     }
+    void operator()(task_batch_t* batch) const {
+        executing_thread_id_ = 0;
+        batch->run();
+    }
 
   private:
     std::size_t m_thread_id{};
@@ -186,16 +255,18 @@ void worker_main(worker_conf_t* my_wc_ptr,
 
 // Using an instance of a custom type allows us to manage the teardown process
 // more easily. TODO: remove the pointless zeroth entry in the vectors/arrays.
+// nworker is nrn_nthread unless scheduling dynamically.
 struct worker_threads_t {
-    worker_threads_t()
-        : m_cond{std::make_unique<std::condition_variable[]>(nrn_nthread)}
-        , m_mut{std::make_unique<std::mutex[]>(nrn_nthread)} {
+    worker_threads_t(std::size_t nworker)
+        : m_nworker{nworker}
+        , m_cond{std::make_unique<std::condition_variable[]>(nworker)}
+        , m_mut{std::make_unique<std::mutex[]>(nworker)} {
         // Note that this does not call the worker_conf_t constructor.
-        CACHELINE_ALLOC(m_wc, worker_conf_t, nrn_nthread);
-        m_worker_threads.reserve(nrn_nthread);
+        CACHELINE_ALLOC(m_wc, worker_conf_t, nworker);
+        m_worker_threads.reserve(nworker);
         // worker_threads[0] does not appear to be used
         m_worker_threads.emplace_back();
-        for (std::size_t i = 1; i < nrn_nthread; ++i) {
+        for (std::size_t i = 1; i < nworker; ++i) {
             new (m_wc + i) worker_conf_t{};
             m_wc[i].thread_id = i;
             m_worker_threads.emplace_back(worker_main, &(m_wc[i]), &(m_cond[i]), &(m_mut[i]));
@@ -210,9 +281,9 @@ struct worker_threads_t {
     }
 
     ~worker_threads_t() {
-        assert(m_worker_threads.size() == nrn_nthread);
+        assert(m_worker_threads.size() == m_nworker);
         wait();
-        for (std::size_t i = 1; i < nrn_nthread; ++i) {
+        for (std::size_t i = 1; i < m_nworker; ++i) {
             {
                 std::lock_guard<std::mutex> _{m_mut[i]};
                 m_wc[i].flag = worker_flag::exit;
@@ -264,9 +335,26 @@ struct worker_threads_t {
         cond.notify_one();
     }
 
+    void assign_job(std::size_t worker, task_batch_t* batch) {
+        assert(worker > 0);
+        auto& cond = m_cond[worker];
+        auto& wc = m_wc[worker];
+        {
+            std::unique_lock<std::mutex> lock{m_mut[worker]};
+            // Wait until the worker is idle.
+            cond.wait(lock, [&wc] { return wc.flag == worker_flag::wait; });
+            assert(std::holds_alternative<std::monostate>(wc.job));
+            assert(wc.thread_id == worker);
+            wc.job = batch;
+            wc.flag = worker_flag::execute_job;
+        }
+        // Notify the worker that it has new work to do.
+        cond.notify_one();
+    }
+
     // Wait until all worker threads are waiting
     void wait() const {
-        for (std::size_t i = 1; i < nrn_nthread; ++i) {
+        for (std::size_t i = 1; i < m_nworker; ++i) {
             auto& wc{m_wc[i]};
             if (busywait_main_) {
                 while (wc.flag != worker_flag::wait) {
@@ -283,6 +371,7 @@ struct worker_threads_t {
     }
 
   private:
+    std::size_t m_nworker{};
     // Cannot easily use std::vector because std::condition_variable is not moveable.
     std::unique_ptr<std::condition_variable[]> m_cond;
     // Cannot easily use std::vector because std::mutex is not moveable.
@@ -291,6 +380,22 @@ struct worker_threads_t {
     worker_conf_t* m_wc{};
 };
 std::unique_ptr<worker_threads_t> worker_threads{};
+
+// One set of worker threads serves both NrnThread jobs and nrn_multitask, so
+// it is sized for whichever needs more.
+void relaunch_workers() {
+    std::size_t const nthread_nworker = thread_parallel_
+                                            ? (dynamic_nworker_ ? dynamic_nworker_ : nrn_nthread)
+                                            : 1;
+    std::size_t const n = std::max(nthread_nworker, multitask_nworker_);
+    if (worker_threads && worker_threads->num_workers() == n) {
+        return;
+    }
+    worker_threads.reset();
+    if (n > 1) {
+        worker_threads = std::make_unique<worker_threads_t>(n);
+    }
+}
 }  // namespace
 
 void nrn_thread_error(const char* s) {
@@ -356,23 +461,33 @@ void nrn_threads_create(int n, bool parallel) {
     }
 #if NRN_ENABLE_THREADS
     // Check if we are enabling/disabling parallelisation over threads
-    if (parallel != static_cast<bool>(worker_threads)) {
-        worker_threads.reset();
+    bool par = parallel && nrn_nthread > 1;
 #if NRNMPI
-        if (nrn_nthread > 1 && nrnmpi_numprocs > 1 && nrn_cannot_use_threads_and_mpi == 1) {
-            if (nrnmpi_myid == 0) {
-                printf("This MPI is not threadsafe so threads are disabled.\n");
-            }
-            return;
-        }
-#endif
-        if (parallel && nrn_nthread > 1) {
-            worker_threads = std::make_unique<worker_threads_t>();
+    if (par && nrnmpi_numprocs > 1 && nrn_cannot_use_threads_and_mpi == 1) {
+        if (nrnmpi_myid == 0) {
+            printf("This MPI is not threadsafe so threads are disabled.\n");
         }
+        par = false;
     }
+#endif
+    thread_parallel_ = par;
+    update_dynamic_nworker();
+    relaunch_workers();
 #endif
 }
 
+void nrn_thread_dynamic(int nworker) {
+    dynamic_request_ = nworker;
+    update_dynamic_nworker();
+#if NRN_ENABLE_THREADS
+    relaunch_workers();
+#endif
+}
+
+int nrn_thread_dynamic() {
+    return dynamic_nworker_;
+}
+
 void nrn_fast_imem_alloc() {
     // Make sure that storage for the fast_imem calculation exists/is destroyed according to
     // nrn_use_fast_imem
@@ -840,48 +955,73 @@ void nrn_hoc_unlock() {
 
 void nrn_multithread_job(worker_job_t job) {
 #if NRN_ENABLE_THREADS
-    if (worker_threads) {
+    if (thread_parallel_) {
         nrn_inthread_ = 1;
-        for (std::size_t i = 1; i < nrn_nthread; ++i) {
-            worker_threads->assign_job(i, job);
+        if (dynamic_nworker_) {
+            dynamic_next_.store(0, std::memory_order_relaxed);
+            for (std::size_t i = 1; i < dynamic_nworker_; ++i) {
+                worker_threads->assign_job(i, job);
+            }
+            run_claimed_threads([job](NrnThread& nt) { job(&nt); });
+        } else {
+            for (std::size_t i = 1; i < nrn_nthread; ++i) {
+                worker_threads->assign_job(i, job);
+            }
+            (*job)(nrn_threads);
         }
-        (*job)(nrn_threads);
         worker_threads->wait();
         nrn_inthread_ = 0;
         return;
     }
 #endif
     for (std::size_t i = 1; i < nrn_nthread; ++i) {
+        executing_thread_id_ = i;
         (*job)(nrn_threads + i);
     }
+    executing_thread_id_ = 0;
     (*job)(nrn_threads);
 }
 
 void nrn_multithread_job(neuron::model_sorted_token const& cache_token,
                          worker_job_with_token_t job) {
 #if NRN_ENABLE_THREADS
-    if (worker_threads) {
+    if (thread_parallel_) {
         nrn_inthread_ = 1;
-        for (std::size_t i = 1; i < nrn_nthread; ++i) {
-            worker_threads->assign_job(i, cache_token, job);
+        if (dynamic_nworker_) {
+            dynamic_next_.store(0, std::memory_order_relaxed);
+            for (std::size_t i = 1; i < dynamic_nworker_; ++i) {
+                worker_threads->assign_job(i, cache_token, job);
+            }
+            run_claimed_threads([job, &cache_token](NrnThread& nt) { job(cache_token, nt); });
+        } else {
+            for (std::size_t i = 1; i < nrn_nthread; ++i) {
+                worker_threads->assign_job(i, cache_token, job);
+            }
+            job(cache_token, nrn_threads[0]);
         }
-        job(cache_token, nrn_threads[0]);
         worker_threads->wait();
         nrn_inthread_ = 0;
         return;
     }
 #endif
     for (std::size_t i = 1; i < nrn_nthread; ++i) {
+        executing_thread_id_ = i;
         job(cache_token, nrn_threads[i]);
     }
+    executing_thread_id_ = 0;
     job(cache_token, nrn_threads[0]);
 }
 
 void nrn_onethread_job(int i, void* (*job)(NrnThread*) ) {
     assert(i >= 0 && i < nrn_nthread);
 #if NRN_ENABLE_THREADS
-    if (worker_threads) {
-        if (i > 0) {
+    if (thread_parallel_) {
+        if (i > 0 && dynamic_nworker_) {
+            // there may be no worker i, any thread will do.
+            int const old = std::exchange(executing_thread_id_, i);
+            (*job)(nrn_threads + i);
+            executing_thread_id_ = old;
+        } else if (i > 0) {
             worker_threads->assign_job(i, job);
             worker_threads->wait();
         } else {
@@ -890,7 +1030,54 @@ void nrn_onethread_job(int i, void* (*job)(NrnThread*) ) {
         return;
     }
 #endif
+    int const old = std::exchange(executing_thread_id_, i);
     (*job)(nrn_threads + i);
+    executing_thread_id_ = old;
+}
+
+void nrn_multitask(std::size_t ntask, void (*task)(void*, std::size_t), void* data) {
+#if NRN_ENABLE_THREADS
+    // Within a NrnThread job the workers are busy.
+    if (worker_threads && !nrn_inthread_ && ntask > 1) {
+        task_batch_t batch{task, data, ntask};
+        std::size_t const nworker = std::min(worker_threads->num_workers(), ntask);
+        for (std::size_t i = 1; i < nworker; ++i) {
+            worker_threads->assign_job(i, &batch);
+        }
+        batch.run();
+        worker_threads->wait();
+        multitask_max_nparticipant_ = std::max(multitask_max_nparticipant_,
+                                               batch.nparticipant.load());
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < ntask; ++i) {
+        task(data, i);
+    }
+    multitask_max_nparticipant_ = std::max(multitask_max_nparticipant_,
+                                           std::min(ntask, std::size_t(1)));
+}
+
+std::size_t nrn_multitask_max_nparticipant() {
+    return std::exchange(multitask_max_nparticipant_, 0);
+}
+
+void nrn_multitask_nworker(int n) {
+    multitask_nworker_ = std::max(n, 1);
+#if NRN_ENABLE_THREADS
+    relaunch_workers();
+#endif
+}
+
+int nrn_multitask_nworker() {
+    return multitask_nworker_;
+}
+
+// Give every worker a job so that it notices a change of busywait_.
+static void wake_workers() {
+    if (worker_threads) {
+        nrn_multitask(worker_threads->num_workers(), nulltask, nullptr);
+    }
 }
 
 void nrn_wait_for_threads() {
@@ -1016,18 +1203,18 @@ void nrn_use_busywait(int b) {
     if (allow_busywait_ && worker_threads) {
         if (b == 0 && busywait_main_ == 1) {
             busywait_ = 0;
-            nrn_multithread_job(nulljob);
+            wake_workers();
             busywait_main_ = 0;
         } else if (b == 1 && busywait_main_ == 0) {
             busywait_main_ = 1;
             worker_threads->wait();
             busywait_ = 1;
-            nrn_multithread_job(nulljob);
+            wake_workers();
         }
     } else {
         if (busywait_main_ == 1) {
             busywait_ = 0;
-            nrn_multithread_job(nulljob);
+            wake_workers();
             busywait_main_ = 0;
         }
     }
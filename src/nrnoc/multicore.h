@@ -127,6 +127,59 @@ int nrn_user_partition();
 void reorder_secorder();
 void nrn_thread_memblist_setup();
 std::size_t nof_worker_threads();
+/** @brief Id of the NrnThread whose job the calling system thread is executing.
+ *
+ * 0 outside of nrn_multithread_job and nrn_onethread_job.
+ */
+int nrn_executing_thread_id();
+/** @brief Nonzero while the worker threads execute a nrn_multithread_job. */
+extern int nrn_inthread_;
+/** @brief Run nrn_nthread NrnThread on nworker worker threads.
+ *
+ * With 0 < nworker < nrn_nthread, each worker repeatedly claims the next
+ * NrnThread not yet processed by the current job, so a model partitioned into
+ * many small NrnThread balances itself over the workers. Otherwise (the
+ * default) there is one worker per NrnThread.
+ */
+void nrn_thread_dynamic(int nworker);
+/** @brief Number of workers used for dynamic scheduling, 0 if not in effect. */
+int nrn_thread_dynamic();
+/** @brief Execute task(data, i) for i in [0, ntask) on the worker threads.
+ *
+ * Tasks are claimed one at a time by the calling thread and the workers that
+ * are not busy with a NrnThread job, so there is no per task allocation or
+ * locking. When there are no workers, or when called from within a
+ * nrn_multithread_job, the tasks are executed sequentially by the caller.
+ * Returns when all tasks are complete.
+ */
+void nrn_multitask(std::size_t ntask, void (*task)(void* data, std::size_t i), void* data);
+/** @brief Execute task(args + i) for i in [0, ntask) as with nrn_multitask. */
+template <typename T>
+void nrn_multitask(std::size_t ntask, void* (*task)(void*), T* args) {
+    struct closure {
+        void* (*task)(void*);
+        T* args;
+    } c{task, args};
+    nrn_multitask(
+        ntask,
+        [](void* data, std::size_t i) {
+            auto* const c = static_cast<closure*>(data);
+            c->task(c->args + i);
+        },
+        &c);
+}
+/** @brief Keep at least n threads, including the main thread, for nrn_multitask.
+ *
+ * Independent of the number of NrnThread. The same worker threads execute
+ * NrnThread jobs and tasks.
+ */
+void nrn_multitask_nworker(int n);
+/** @brief The number of threads requested with nrn_multitask_nworker(n). */
+int nrn_multitask_nworker();
+/** @brief The most threads that executed tasks of one nrn_multitask since the
+ *  previous call.
+ */
+std::size_t nrn_multitask_max_nparticipant();
 
 
 // helper function for iterating over ``NrnThread``s
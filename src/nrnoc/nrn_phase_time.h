@@ -0,0 +1,30 @@
+#pragma once
+
+/*
+Optional per NrnThread breakdown of fixed step computation time, enabled
+(and zeroed) with ParallelContext.phase_time(). Each thread accumulates only
+into its own row so no locking is needed. When disabled the cost is a test
+of nrn_phase_time_on_ per phase.
+*/
+
+enum NrnPhase {
+    NRN_PHASE_DELIVER_EVENTS,
+    NRN_PHASE_SETUP_TREE_MATRIX,
+    NRN_PHASE_MATRIX_SOLVER,
+    NRN_PHASE_SECOND_ORDER_CUR,
+    NRN_PHASE_UPDATE,
+    NRN_PHASE_STATE_UPDATE,
+    NRN_PHASE_RECORD,
+    NRN_PHASE_COUNT
+};
+
+extern bool nrn_phase_time_on_;
+
+void nrn_phase_time_enable(bool on);
+const char* nrn_phase_name(int phase);
+int nrn_phase_lookup(const char* name);  // -1 if not a phase name
+double nrn_phase_time(int tid, int phase);
+void nrn_phase_time_add(int tid, int phase, double dt);
+// per mechanism type nrn_cur (state == false) and nrn_state (state == true)
+double nrn_phase_mech_time(int tid, int type, bool state);
+void nrn_phase_mech_time_add(int tid, int type, bool state, double dt);
@@ -13,6 +13,7 @@ extern void init_net_events();
 extern void nrn_record_init();
 extern void nrn_play_init();
 void fixed_record_continuous(neuron::model_sorted_token const&, NrnThread& nt);
+void nrn_record_commit();
 extern void fixed_play_continuous(NrnThread* nt);
 extern void nrn_solver_prepare();
 extern "C" void nrn_random_play();
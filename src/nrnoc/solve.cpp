@@ -357,7 +357,7 @@ void nrn_solve(NrnThread* _nt) {
         int e;
         nrn_thread_error("solve use_sparse13");
         update_sp13_mat_based_on_actual_d(_nt);
-        e = spFactor(_nt->_sp13mat);
+        e = spFactorCompiled(_nt->_sp13mat);
         if (e != spOKAY) {
             switch (e) {
             case spZERO_DIAG:
@@ -369,7 +369,7 @@ void nrn_solve(NrnThread* _nt) {
             }
         }
         update_sp13_rhs_based_on_actual_rhs(_nt);
-        spSolve(_nt->_sp13mat, _nt->_sp13_rhs, _nt->_sp13_rhs);
+        spSolveCompiled(_nt->_sp13mat, _nt->_sp13_rhs, _nt->_sp13_rhs);
         update_actual_d_based_on_sp13_mat(_nt);
         update_actual_rhs_based_on_sp13_rhs(_nt);
     } else {
@@ -12,6 +12,7 @@
 #include "neuron/container/soa_container.hpp"
 #include "node_order_optim/node_order_optim.h"
 #include "nonvintblock.h"
+#include "nrn_phase_time.h"
 #include "nrndae_c.h"
 #include "nrniv_mf.h"
 #include "nrnmpi.h"
@@ -382,7 +383,8 @@ void nrn_rhs(neuron::model_sorted_token const& cache_token, NrnThread& nt) {
     i1 = 0;
     i2 = i1 + _nt->ncell;
     i3 = _nt->end;
-    if (_nt->id == 0 && nrn_mech_wtime_) {
+    bool const measure_mech_wtime{_nt->id == 0 && nrn_mech_wtime_};
+    if (measure_mech_wtime || nrn_phase_time_on_) {
         measure = 1;
     }
 
@@ -426,7 +428,13 @@ void nrn_rhs(neuron::model_sorted_token const& cache_token, NrnThread& nt) {
             current(cache_token, _nt, tml->ml, tml->index);
             nrn::Instrumentor::phase_end(mechname.c_str());
             if (measure) {
-                nrn_mech_wtime_[tml->index] += nrnmpi_wtime() - w;
+                double const elapsed = nrnmpi_wtime() - w;
+                if (measure_mech_wtime) {
+                    nrn_mech_wtime_[tml->index] += elapsed;
+                }
+                if (nrn_phase_time_on_) {
+                    nrn_phase_mech_time_add(_nt->id, tml->index, false, elapsed);
+                }
             }
             if (errno) {
                 if (nrn_errno_check(tml->index)) {
@@ -9,14 +9,14 @@ a linked list of Grid_nodes
 #include "nrnpython.h"
 #include "grids.h"
 #include "rxd.h"
+#include <../nrnoc/multicore.h>
+#include "rxd_tridiag.h"
 
 extern int NUM_THREADS;
 double* dt_ptr;
 double* t_ptr;
 Grid_node* Parallel_grids[100] = {NULL};
 
-/* globals used by ECS do_currents */
-extern TaskQueue* AllTasks;
 /*Current from multicompartment reations*/
 extern int _memb_curr_total;
 extern int* _rxd_induced_currents_grid;
@@ -157,8 +157,10 @@ ECS_Grid_node::ECS_Grid_node(PyHocObject* my_states,
     ecs_tasks = NULL;
     ecs_tasks = (ECSAdiGridData*) malloc(NUM_THREADS * sizeof(ECSAdiGridData));
     for (k = 0; k < NUM_THREADS; k++) {
+        /* room for a tile of lines and their factorization, see ecs_dg_adi_lanes */
         ecs_tasks[k].scratchpad = (double*) malloc(
-            sizeof(double) * MAX(my_num_states_x, MAX(my_num_states_y, my_num_states_z)));
+            sizeof(double) * (ECS_ADI_LANES + 2) *
+            MAX(my_num_states_x, MAX(my_num_states_y, my_num_states_z)));
         ecs_tasks[k].g = this;
     }
 
@@ -167,18 +169,21 @@ ECS_Grid_node::ECS_Grid_node(PyHocObject* my_states,
     ecs_adi_dir_x->states_in = states;
     ecs_adi_dir_x->states_out = states_x;
     ecs_adi_dir_x->line_size = my_num_states_x;
+    ecs_adi_dir_x->ecs_dg_adi_rhs = NULL;
 
 
     ecs_adi_dir_y = (ECSAdiDirection*) malloc(sizeof(ECSAdiDirection));
     ecs_adi_dir_y->states_in = states_x;
     ecs_adi_dir_y->states_out = states_y;
     ecs_adi_dir_y->line_size = my_num_states_y;
+    ecs_adi_dir_y->ecs_dg_adi_rhs = NULL;
 
 
     ecs_adi_dir_z = (ECSAdiDirection*) malloc(sizeof(ECSAdiDirection));
     ecs_adi_dir_z->states_in = states_y;
     ecs_adi_dir_z->states_out = states_x;
     ecs_adi_dir_z->line_size = my_num_states_z;
+    ecs_adi_dir_z->ecs_dg_adi_rhs = NULL;
 
     this->atolscale = atolscale;
 
@@ -840,7 +845,7 @@ void ECS_Grid_node::set_num_threads(const int n) {
     free(ecs_tasks);
     ecs_tasks = (ECSAdiGridData*) malloc(n * sizeof(ECSAdiGridData));
     for (i = 0; i < n; i++) {
-        ecs_tasks[i].scratchpad = (double*) malloc(sizeof(double) *
+        ecs_tasks[i].scratchpad = (double*) malloc(sizeof(double) * (ECS_ADI_LANES + 2) *
                                                    MAX(size_x, MAX(size_y, size_z)));
         ecs_tasks[i].g = this;
     }
@@ -897,14 +902,7 @@ void ECS_Grid_node::do_grid_currents(double* output, double dt, int grid_id) {
         tasks[i].offset = MIN((i + 1) * tasks_per_thread, m);
         tasks[i].val = val;
     }
-    for (i = 0; i < NUM_THREADS - 1; i++) {
-        TaskQueue_add_task(AllTasks, &gather_currents, &tasks[i], NULL);
-    }
-    /* run one task in the main thread */
-    gather_currents(&tasks[NUM_THREADS - 1]);
-
-    /* wait for them to finish */
-    TaskQueue_sync(AllTasks);
+    nrn_multitask(NUM_THREADS, &gather_currents, tasks);
     free(tasks);
 #if NRNMPI
     if (nrnmpi_use) {
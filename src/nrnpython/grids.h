@@ -233,6 +233,15 @@ struct ECSAdiDirection {
                            double const* const,
                            double* const,
                            double* const);
+    /* assembles the RHS of a line with a given stride for the batched solver,
+     * NULL if the matrix is not the same for all lines */
+    void (*ecs_dg_adi_rhs)(ECS_Grid_node*,
+                           const double,
+                           const int,
+                           const int,
+                           double const* const,
+                           double* const,
+                           const int);
     double* states_in;
     double* states_out;
     int line_size;
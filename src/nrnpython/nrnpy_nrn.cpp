@@ -11,6 +11,7 @@
 #include "nrnpy.h"
 #include "nrnpy_utils.h"
 #include "convert_cxx_exceptions.hpp"
+#include "neuron/model_data.hpp"
 #include "neuron/unique_cstr.hpp"
 
 #ifndef M_PI
@@ -18,6 +19,7 @@
 #endif
 
 #include <membfunc.h>
+#include <multicore.h>
 #include <parse.hpp>
 
 #include <cmath>
@@ -108,6 +110,23 @@ struct NPyOpaquePointer {
     PyObject_HEAD
 };
 
+// Zero-copy view of one floating point column of the node or mechanism
+// SoA storage. The storage is kept frozen for the lifetime of the view, so
+// the column cannot be reallocated or permuted underneath a buffer exported
+// from it.
+struct NPyFieldView {
+    PyObject_HEAD
+    neuron::container::Node::storage::frozen_token_type* node_token_;
+    neuron::container::Mechanism::storage::frozen_token_type* mech_token_;
+    double* data_;
+    Py_ssize_t shape_[2];
+    Py_ssize_t strides_[2];
+    int ndim_;
+    int type_;  // -1 for node data
+    int field_;
+    int exports_;
+};
+
 PyTypeObject* psection_type;
 static PyTypeObject* pallseg_of_sec_iter_type;
 static PyTypeObject* pseg_of_sec_iter_type;
@@ -118,6 +137,7 @@ static PyTypeObject* pmechfunc_generic_type;
 static PyTypeObject* pvar_of_mech_iter_generic_type;
 static PyTypeObject* range_type;
 static PyTypeObject* opaque_pointer_type;
+static PyTypeObject* field_view_type;
 
 PyObject* pmech_types;  // Python map for name to Mechanism
 PyObject* rangevars_;   // Python map for name to Symbol
@@ -2965,6 +2985,314 @@ static PyMethodDef NPyRangeVar_methods[] = {
 
 static PyMemberDef NPyMechObj_members[] = {{NULL}};
 
+static void NPyFieldView_dealloc(NPyFieldView* self) {
+    delete self->node_token_;
+    delete self->mech_token_;
+    ((PyObject*) self)->ob_type->tp_free((PyObject*) self);
+}
+
+static void NPyFieldView_dealloc_safe(NPyFieldView* self) {
+    // Not wrapped because it must not throw.
+    NPyFieldView_dealloc(self);
+}
+
+static bool field_view_released(NPyFieldView* self) {
+    if (!self->node_token_ && !self->mech_token_) {
+        PyErr_SetString(PyExc_ValueError, "operation on a released field_view");
+        return true;
+    }
+    return false;
+}
+
+static int NPyFieldView_getbuffer(NPyFieldView* self, Py_buffer* view, int flags) {
+    if (field_view_released(self)) {
+        view->obj = NULL;
+        return -1;
+    }
+    view->buf = self->data_;
+    view->obj = (PyObject*) self;
+    Py_INCREF(self);
+    view->len = self->shape_[0] * (self->ndim_ == 2 ? self->shape_[1] : 1) * sizeof(double);
+    view->readonly = 0;
+    view->itemsize = sizeof(double);
+    view->format = (flags & PyBUF_FORMAT) ? (char*) "d" : NULL;
+    view->ndim = self->ndim_;
+    view->shape = (flags & PyBUF_ND) ? self->shape_ : NULL;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->strides_ : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    ++self->exports_;
+    return 0;
+}
+
+static void NPyFieldView_releasebuffer(NPyFieldView* self, Py_buffer* view) {
+    --self->exports_;
+}
+
+// nrn.field_view("v") or nrn.field_view("area") for node data,
+// nrn.field_view("hh", "gnabar") for a mechanism RANGE variable.
+static PyObject* nrnpy_field_view(PyObject* self, PyObject* args) {
+    char* name;
+    char* var = nullptr;
+    if (!PyArg_ParseTuple(args, "s|s", &name, &var)) {
+        return NULL;
+    }
+    int type = -1;
+    int field = 0;
+    if (!var) {
+        if (strcmp(name, "v") != 0 && strcmp(name, "area") != 0) {
+            PyErr_Format(PyExc_ValueError, "field_view: no node field named %s", name);
+            return NULL;
+        }
+    } else {
+        Symbol* msym = hoc_lookup(name);
+        if (msym && msym->type == MECHANISM) {
+            type = msym->subtype;
+        } else if (msym && msym->type == TEMPLATE && msym->u.ctemplate->is_point_) {
+            for (int i = 0; i < n_memb_func; ++i) {
+                if (nrn_pnt_template_[i] == msym->u.ctemplate) {
+                    type = i;
+                    break;
+                }
+            }
+        }
+        if (type < 0) {
+            PyErr_Format(PyExc_ValueError, "field_view: %s is not a mechanism", name);
+            return NULL;
+        }
+        auto const& mech_data = neuron::model().mechanism_data(type);
+        auto const& tag = mech_data.get_tag<neuron::container::Mechanism::field::FloatingPoint>();
+        std::string const suffixed = std::string(var) + "_" + name;
+        field = -1;
+        for (std::size_t i = 0; i < tag.num_variables(); ++i) {
+            if (tag.info(i).name == var || tag.info(i).name == suffixed) {
+                field = i;
+                break;
+            }
+        }
+        if (field < 0) {
+            PyErr_Format(PyExc_ValueError, "field_view: %s has no RANGE variable %s", name, var);
+            return NULL;
+        }
+    }
+    // Bring the thread data structures up to date and sort so the row order
+    // is the per thread order used by the simulation, then hold our own token
+    // so it stays that way.
+    if (tree_changed) {
+        setup_topology();
+    }
+    if (v_structure_change) {
+        v_setup_vectors();
+    }
+    if (diam_changed) {
+        recalc_diam();
+    }
+    nrn_ensure_model_data_are_sorted();
+    auto* fv = PyObject_New(NPyFieldView, field_view_type);
+    if (!fv) {
+        return NULL;
+    }
+    fv->node_token_ = nullptr;
+    fv->mech_token_ = nullptr;
+    fv->type_ = type;
+    fv->field_ = field;
+    fv->exports_ = 0;
+    int array_dim = 1;
+    if (type < 0) {
+        auto& node_data = neuron::model().node_data();
+        fv->node_token_ = new neuron::container::Node::storage::frozen_token_type{
+            node_data.issue_frozen_token()};
+        fv->data_ = (name[0] == 'v')
+                        ? node_data.get_data_ptrs<neuron::container::Node::field::Voltage>()[0]
+                        : node_data.get_data_ptrs<neuron::container::Node::field::Area>()[0];
+        fv->shape_[0] = node_data.size();
+    } else {
+        using neuron::container::Mechanism::field::FloatingPoint;
+        auto& mech_data = neuron::model().mechanism_data(type);
+        fv->mech_token_ = new neuron::container::Mechanism::storage::frozen_token_type{
+            mech_data.issue_frozen_token()};
+        fv->data_ = mech_data.get_data_ptrs<FloatingPoint>()[field];
+        array_dim = mech_data.get_array_dims<FloatingPoint>()[field];
+        fv->shape_[0] = mech_data.size();
+    }
+    // Array variables are stored row major: element j of row i is at
+    // i * array_dim + j.
+    fv->ndim_ = array_dim > 1 ? 2 : 1;
+    fv->shape_[1] = array_dim;
+    fv->strides_[0] = array_dim * sizeof(double);
+    fv->strides_[1] = sizeof(double);
+    return (PyObject*) fv;
+}
+
+static PyObject* nrnpy_field_view_safe(PyObject* self, PyObject* args) {
+    return nrn::convert_cxx_exceptions(nrnpy_field_view, self, args);
+}
+
+static Py_ssize_t NPyFieldView_len(NPyFieldView* self) {
+    return self->shape_[0];
+}
+
+static Py_ssize_t NPyFieldView_len_safe(NPyFieldView* self) {
+    return nrn::convert_cxx_exceptions(NPyFieldView_len, self);
+}
+
+// Row of a Segment (node data or density mechanism) or point process in
+// this view, -1 with an exception set if it has none.
+static Py_ssize_t field_view_row(NPyFieldView* self, PyObject* po) {
+    if (PyObject_TypeCheck(po, psegment_type)) {
+        auto* pyseg = (NPySegObj*) po;
+        Section* sec = pyseg->pysec_->sec_;
+        if (!sec->prop) {
+            PyErr_SetString(PyExc_ReferenceError, "can't access a deleted section");
+            return -1;
+        }
+        Node* nd = node_exact(sec, pyseg->x_);
+        if (self->type_ < 0) {
+            return nd->id().current_row();
+        }
+        if (memb_func[self->type_].is_point) {
+            PyErr_SetString(PyExc_TypeError,
+                            "field_view: index a POINT_PROCESS view with the point process");
+            return -1;
+        }
+        Prop* p = nrn_mechanism(self->type_, nd);
+        if (!p) {
+            PyErr_Format(PyExc_ValueError,
+                         "field_view: %s not inserted in segment",
+                         memb_func[self->type_].sym->name);
+            return -1;
+        }
+        return p->current_row();
+    }
+    if (self->type_ >= 0 && PyObject_TypeCheck(po, hocobject_type)) {
+        Object* ho = nrnpy_po2ho(po);
+        Py_ssize_t row = -1;
+        if (ho && ho->ctemplate == nrn_pnt_template_[self->type_]) {
+            row = ob2pntproc(ho)->prop->current_row();
+        } else {
+            PyErr_Format(PyExc_TypeError,
+                         "field_view: not a %s instance",
+                         memb_func[self->type_].sym->name);
+        }
+        hoc_obj_unref(ho);
+        return row;
+    }
+    PyErr_SetString(PyExc_TypeError, "field_view: expected a Segment or point process");
+    return -1;
+}
+
+static PyObject* NPyFieldView_index(NPyFieldView* self, PyObject* args) {
+    PyObject* po;
+    if (field_view_released(self) || !PyArg_ParseTuple(args, "O", &po)) {
+        return NULL;
+    }
+    if (PyObject_TypeCheck(po, psegment_type) || PyObject_TypeCheck(po, hocobject_type)) {
+        auto const row = field_view_row(self, po);
+        return row < 0 ? NULL : PyLong_FromSsize_t(row);
+    }
+    auto seq = nb::steal(PySequence_Fast(po, "field_view.index: expected a Segment, "
+                                             "point process, or a sequence of them"));
+    if (!seq) {
+        return NULL;
+    }
+    auto const n = PySequence_Fast_GET_SIZE(seq.ptr());
+    auto result = nb::steal(PyList_New(n));
+    for (Py_ssize_t i = 0; i < n; ++i) {
+        auto const row = field_view_row(self, PySequence_Fast_GET_ITEM(seq.ptr(), i));
+        if (row < 0) {
+            return NULL;
+        }
+        PyList_SET_ITEM(result.ptr(), i, PyLong_FromSsize_t(row));
+    }
+    return result.release().ptr();
+}
+
+static PyObject* NPyFieldView_index_safe(NPyFieldView* self, PyObject* args) {
+    return nrn::convert_cxx_exceptions(NPyFieldView_index, self, args);
+}
+
+// List, in row order, of the Segment each row belongs to. None for rows that
+// are not located in a section (e.g. ARTIFICIAL_CELL).
+static PyObject* NPyFieldView_segments(NPyFieldView* self) {
+    if (field_view_released(self)) {
+        return NULL;
+    }
+    auto const n = self->shape_[0];
+    std::vector<Node*> nodes(n, nullptr);
+    for (int it = 0; it < nrn_nthread; ++it) {
+        NrnThread* nt = nrn_threads + it;
+        if (self->type_ < 0) {
+            for (int i = 0; i < nt->end; ++i) {
+                nodes[nt->_node_data_offset + i] = nt->_v_node[i];
+            }
+        } else if (!nrn_is_artificial_[self->type_]) {
+            Memb_list* ml = nt->_ml_list[self->type_];
+            if (ml) {
+                auto const offset = ml->get_storage_offset();
+                for (int i = 0; i < ml->nodecount; ++i) {
+                    nodes[offset + i] = ml->nodelist[i];
+                }
+            }
+        }
+    }
+    auto result = nb::steal(PyList_New(n));
+    for (Py_ssize_t i = 0; i < n; ++i) {
+        Node* nd = nodes[i];
+        PyObject* item;
+        if (nd && nd->sec) {
+            item = newpyseghelp(nd->sec, nrn_arc_position(nd->sec, nd));
+            if (!item) {
+                return NULL;
+            }
+        } else {
+            Py_INCREF(Py_None);
+            item = Py_None;
+        }
+        PyList_SET_ITEM(result.ptr(), i, item);
+    }
+    return result.release().ptr();
+}
+
+static PyObject* NPyFieldView_segments_safe(NPyFieldView* self) {
+    return nrn::convert_cxx_exceptions(NPyFieldView_segments, self);
+}
+
+// Drop the frozen token so the model structure can change again. Not allowed
+// while a buffer exported from this view is still alive.
+static PyObject* NPyFieldView_release(NPyFieldView* self) {
+    if (self->exports_ > 0) {
+        PyErr_SetString(PyExc_BufferError,
+                        "field_view.release: arrays that use this view still exist");
+        return NULL;
+    }
+    delete self->node_token_;
+    delete self->mech_token_;
+    self->node_token_ = nullptr;
+    self->mech_token_ = nullptr;
+    self->data_ = nullptr;
+    self->shape_[0] = 0;
+    Py_RETURN_NONE;
+}
+
+static PyObject* NPyFieldView_release_safe(NPyFieldView* self) {
+    return nrn::convert_cxx_exceptions(NPyFieldView_release, self);
+}
+
+static PyMethodDef NPyFieldView_methods[] = {
+    {"index",
+     (PyCFunction) NPyFieldView_index_safe,
+     METH_VARARGS,
+     "Row(s) of a Segment, point process, or sequence of them"},
+    {"segments",
+     (PyCFunction) NPyFieldView_segments_safe,
+     METH_NOARGS,
+     "List of the Segment of each row, in row order"},
+    {"release",
+     (PyCFunction) NPyFieldView_release_safe,
+     METH_NOARGS,
+     "Allow the model structure to change again"},
+    {NULL}};
+
 // Returns a new reference.
 PyObject* nrnpy_cas(PyObject* self, PyObject* args) {
     Section* sec = nrn_noerr_access();
@@ -2987,6 +3315,10 @@ static PyMethodDef nrnpy_methods[] = {
      nrnpy_set_psection_safe,
      METH_VARARGS,
      "Specify the nrn.Section.psection callback."},
+    {"field_view",
+     nrnpy_field_view_safe,
+     METH_VARARGS,
+     "Zero-copy buffer of a node or mechanism RANGE variable column."},
     {NULL}};
 
 #include "nrnpy_nrn.h"
@@ -3053,6 +3385,15 @@ PyObject* nrnpy_nrn(void) {
         goto fail;
     Py_INCREF(opaque_pointer_type);
 
+    field_view_type = (PyTypeObject*) PyType_FromSpec(&nrnpy_FieldViewType_spec);
+    if (!field_view_type)
+        goto fail;
+    // Py_bf_getbuffer is not accepted by PyType_FromSpec before Python 3.9
+    field_view_type->tp_as_buffer->bf_getbuffer = (getbufferproc) NPyFieldView_getbuffer;
+    field_view_type->tp_as_buffer->bf_releasebuffer = (releasebufferproc)
+        NPyFieldView_releasebuffer;
+    Py_INCREF(field_view_type);
+
     m = nb::steal(PyModule_Create(&nrnsectionmodule));  // like nrn but namespace will not include
                                                         // mechanims.
     PyModule_AddObject(m.ptr(), "Section", (PyObject*) psection_type);
@@ -3065,6 +3406,7 @@ PyObject* nrnpy_nrn(void) {
     PyModule_AddObject(m.ptr(), "Section", (PyObject*) psection_type);
     PyModule_AddObject(m.ptr(), "Segment", (PyObject*) psegment_type);
     PyModule_AddObject(m.ptr(), "OpaquePointer", (PyObject*) opaque_pointer_type);
+    PyModule_AddObject(m.ptr(), "FieldView", (PyObject*) field_view_type);
 
     pmech_generic_type = (PyTypeObject*) PyType_FromSpec(&nrnpy_MechanismType_spec);
     pmechfunc_generic_type = (PyTypeObject*) PyType_FromSpec(&nrnpy_MechFuncType_spec);
@@ -178,6 +178,21 @@ static PyType_Spec nrnpy_OpaquePointerType_spec = {
     nrnpy_OpaquePointerType_slots,
 };
 
+static PyType_Slot nrnpy_FieldViewType_slots[] = {
+    {Py_tp_dealloc, (void*) NPyFieldView_dealloc_safe},
+    {Py_tp_methods, (void*) NPyFieldView_methods},
+    {Py_sq_length, (void*) NPyFieldView_len_safe},
+    {Py_tp_doc, (void*) "Zero-copy buffer of a node or mechanism RANGE variable column"},
+    {0, 0},
+};
+static PyType_Spec nrnpy_FieldViewType_spec = {
+    "nrn.FieldView",
+    sizeof(NPyFieldView),
+    0,
+    Py_TPFLAGS_DEFAULT,
+    nrnpy_FieldViewType_slots,
+};
+
 static struct PyModuleDef nrnmodule = {PyModuleDef_HEAD_INIT,
                                        "nrn",
                                        "NEURON interaction with Python",
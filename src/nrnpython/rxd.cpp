@@ -11,7 +11,6 @@
 #include "nrnwrap_Python.h"
 #include "nrnpython.h"
 
-#include <thread>
 #include <vector>
 #include "ocmatrix.h"
 #include "ivocvect.h"
@@ -32,14 +31,6 @@ unsigned char initialized = FALSE;
 */
 extern NrnThread* nrn_threads;
 int NUM_THREADS = 1;
-namespace nrn {
-namespace rxd {
-std::vector<std::thread> Threads;
-TaskQueue task_queue;
-}  // namespace rxd
-}  // namespace nrn
-TaskQueue* AllTasks{&nrn::rxd::task_queue};
-using namespace nrn::rxd;
 
 extern double* dt_ptr;
 extern double* t_ptr;
@@ -1002,9 +993,7 @@ extern "C" NRN_EXPORT void clear_rates() {
     _reactions = NULL;
     /*clear extracellular reactions*/
     clear_rates_ecs();
-    // There are NUM_THREADS-1 std::thread objects alive, and these need to be
-    // cleaned up before exit (otherwise the std::thread destructor will call
-    // std::terminate.).
+    // Release the worker threads that were kept for rxd.
     set_num_threads(1);
 }
 
@@ -1072,131 +1061,25 @@ extern "C" NRN_EXPORT void setup_solver(double* my_states,
     prev_structure_change_cnt = structure_change_cnt;
 }
 
-void TaskQueue_add_task(TaskQueue* q, void* (*task)(void*), void* args, void* result) {
-    auto* t = new TaskList{};
-    t->task = task;
-    t->args = args;
-    t->result = result;
-    t->next = nullptr;
-
-    // Add task to the queue
-    {
-        std::lock_guard<std::mutex> _{q->task_mutex};
-        if (!q->first) {
-            // empty queue
-            q->first = t;
-            q->last = t;
-        } else {
-            // queue not empty
-            q->last->next = t;
-            q->last = t;
-        }
-        {
-            std::lock_guard<std::mutex> _{q->waiting_mutex};
-            ++q->length;
-        }
-    }
-
-    // signal a waiting thread that there is a new task to pick up
-    q->task_cond.notify_one();
-}
-
-void TaskQueue_exe_tasks(std::size_t thread_index, TaskQueue* q) {
-    for (;;) {
-        // Wait for a task to be available in the queue, then execute it.
-        {
-            TaskList* job{};
-            {
-                std::unique_lock<std::mutex> lock{q->task_mutex};
-                // Wait until either for a new task to be received or for this
-                // thread to be told to exit.
-                q->task_cond.wait(lock,
-                                  [q, thread_index] { return q->first || q->exit[thread_index]; });
-                if (q->exit[thread_index]) {
-                    return;
-                }
-                job = q->first;
-                q->first = job->next;
-            }
-            // Execute the task
-            job->result = job->task(job->args);
-            delete job;
-        }
-        // Decrement the list length, if it's now empty then broadcast that to
-        // the master thread, which may be waiting for the queue to be empty.
-        auto const new_length = [q] {
-            std::lock_guard<std::mutex> _{q->waiting_mutex};
-            return --(q->length);
-        }();
-        // The immediately-executed lambda means we release the mutex before
-        // calling notify_one()
-        if (new_length == 0) {
-            // Queue is empty. Notify the main thread, which may be blocking on
-            // this condition.
-            q->waiting_cond.notify_one();
-        }
-    }
-}
-
-
+// Tasks are executed by the NEURON worker threads (see nrn_multitask), which
+// are shared with the NrnThread jobs, so there is only one set of threads
+// competing for the cores.
 extern "C" NRN_EXPORT void set_num_threads(const int n) {
     assert(n > 0);
-    assert(NUM_THREADS > 0);
-    // n and NUM_THREADS include the main thread, old_num and new_num refer to
-    // the number of std::thread workers
-    std::size_t const old_num = NUM_THREADS - 1;
-    std::size_t const new_num = n - 1;
-    assert(old_num == Threads.size());
-    assert(old_num == task_queue.exit.size());
-    if (new_num < old_num) {
-        // Kill some threads. First, wait until the queue is empty.
-        TaskQueue_sync(&task_queue);
-        // Now signal to the threads that are to be killed that they need to
-        // exit.
-        {
-            std::lock_guard<std::mutex> _{task_queue.task_mutex};
-            for (auto k = new_num; k < old_num; ++k) {
-                task_queue.exit[k] = true;
-            }
-        }
-        task_queue.task_cond.notify_all();
-        // Finally, join those threads and destroy the std::thread objects.
-        for (auto k = new_num; k < old_num; ++k) {
-            Threads[k].join();
-        }
-        // And update the structures
-        {
-            std::lock_guard<std::mutex> _{task_queue.task_mutex};
-            Threads.resize(new_num);
-            task_queue.exit.resize(new_num);
-        }
-    } else if (new_num > old_num) {
-        // Create some threads
-        std::lock_guard<std::mutex> _{task_queue.task_mutex};
-        task_queue.exit.reserve(new_num);
-        Threads.reserve(new_num);
-        for (auto k = old_num; k < new_num; ++k) {
-            assert(k == Threads.size());
-            Threads.emplace_back(TaskQueue_exe_tasks, k, &task_queue);
-            task_queue.exit.emplace_back(false);
-        }
-    }
-    assert(new_num == Threads.size());
-    assert(new_num == task_queue.exit.size());
+    nrn_multitask_nworker(n);
     set_num_threads_3D(n);
     NUM_THREADS = n;
 }
 
-void TaskQueue_sync(TaskQueue* q) {
-    // Wait till the queue is empty
-    std::unique_lock<std::mutex> lock{q->waiting_mutex};
-    q->waiting_cond.wait(lock, [q] { return q->length == 0; });
-}
-
 extern "C" NRN_EXPORT int get_num_threads(void) {
     return NUM_THREADS;
 }
 
+// The most threads that executed one batch of tasks since the previous call.
+extern "C" NRN_EXPORT int rxd_max_nparticipant(void) {
+    return static_cast<int>(nrn_multitask_max_nparticipant());
+}
+
 
 void _fadvance(void) {
     double dt = *dt_ptr;
@@ -1,7 +1,4 @@
 #pragma once
-#include <condition_variable>
-#include <mutex>
-#include <thread>
 #include <vector>
 
 #define SPECIES_ABSENT -1
@@ -65,22 +62,6 @@ struct ICSReactions {
     struct ICSReactions* next;
 };
 
-struct TaskList {
-    void* (*task)(void*);
-    void* args;
-    void* result;
-    struct TaskList* next;
-};
-
-struct TaskQueue {
-    std::condition_variable task_cond, waiting_cond;
-    std::mutex task_mutex, waiting_mutex;
-    std::vector<bool> exit;
-    int length{};
-    struct TaskList* first;
-    struct TaskList* last;
-};
-
 extern "C" void set_num_threads(const int);
 void _fadvance(void);
 void _fadvance_fixed_step_3D(void);
@@ -204,8 +185,5 @@ void do_ics_reactions(double*, double*, double*, double*);
 void get_all_reaction_rates(double*, double*, double*);
 void _ecs_ode_reinit(double*);
 void do_currents(Grid_node*, double*, double, int);
-void TaskQueue_add_task(TaskQueue*, void* (*task)(void* args), void*, void*);
-void TaskQueue_exe_tasks(std::size_t, TaskQueue*);
-void TaskQueue_sync(TaskQueue*);
 void ecs_atolscale(double*);
 void apply_node_flux3D(Grid_node*, double, double*);
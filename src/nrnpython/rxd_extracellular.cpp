@@ -4,6 +4,8 @@
 #include <string.h>
 #include "grids.h"
 #include "rxd.h"
+#include <../nrnoc/multicore.h>
+#include "rxd_tridiag.h"
 #include "nrnwrap_Python.h"
 #include <cmath>
 #include <ocmatrix.h>
@@ -20,7 +22,6 @@ static void ecs_refresh_reactions(int);
 ReactGridData* threaded_reactions_tasks;
 
 extern int NUM_THREADS;
-extern TaskQueue* AllTasks;
 extern double* t_ptr;
 extern double* states;
 
@@ -547,19 +548,10 @@ void* ecs_do_reactions(void* dataptr) {
 
 /* run_threaded_reactions
  * Array ReactGridData tasks length NUM_THREADS and calls ecs_do_reactions and
- * executes each task with a separate thread
+ * executes the tasks on the NEURON worker threads
  */
 static void run_threaded_reactions(ReactGridData* tasks) {
-    int k;
-    /* launch threads */
-    for (k = 0; k < NUM_THREADS - 1; k++) {
-        TaskQueue_add_task(AllTasks, &ecs_do_reactions, &tasks[k], NULL);
-    }
-    /* run one task in the main thread */
-    ecs_do_reactions(&tasks[NUM_THREADS - 1]);
-
-    /* wait for them to finish */
-    TaskQueue_sync(AllTasks);
+    nrn_multitask(NUM_THREADS, &ecs_do_reactions, tasks);
 }
 
 void _fadvance_fixed_step_3D(void) {
@@ -1029,32 +1021,40 @@ ubc_diag, b, c);
 */
 
 
-/* dg_adi_x performs the first of 3 steps in DG-ADI
- * g    -   the parameters and state of the grid
- * dt   -   the time step
- * y    -   the index for the y plane
- * z    -   the index for the z plane
- * state    -   where the output of this step is stored
- * scratch  - scratchpad array of doubles, length g->size_x - 1
+/* ecs_dirichlet_boundary_line sets the N values in out of a line on the
+ * boundary of the grid to the boundary value when the boundary condition is
+ * DIRICHLET, and then returns true. The line is at i, j in the two other
+ * directions, of sizes sizei and sizej.
+ * TODO: Get rid of this by not calling dg_adi when on the boundary for DIRICHLET conditions
  */
-static void ecs_dg_adi_x(ECS_Grid_node* g,
-                         const double dt,
-                         const int y,
-                         const int z,
-                         double const* const state,
-                         double* const RHS,
-                         double* const scratch) {
+static bool ecs_dirichlet_boundary_line(ECS_Grid_node* g,
+                                        const int i,
+                                        const int j,
+                                        const int sizei,
+                                        const int sizej,
+                                        const int N,
+                                        double* const out) {
+    if (g->bc->type != DIRICHLET || (i != 0 && j != 0 && i != sizei - 1 && j != sizej - 1)) {
+        return false;
+    }
+    for (int n = 0; n < N; n++)
+        out[n] = g->bc->value;
+    return true;
+}
+
+/* ecs_dg_adi_rhs_x computes the right hand side of the first of 3 steps in
+ * DG-ADI for the line at y, z. Element x is stored in RHS[x * stride].
+ */
+static void ecs_dg_adi_rhs_x(ECS_Grid_node* g,
+                             const double dt,
+                             const int y,
+                             const int z,
+                             double const* const state,
+                             double* const RHS,
+                             const int stride) {
     int yp, ym, zp, zm;
     int x;
-    double r = g->dc_x * dt / SQ(g->dx);
     double div_y, div_z;
-    /*TODO: Get rid of this by not calling dg_adi when on the boundary for DIRICHLET conditions*/
-    if (g->bc->type == DIRICHLET &&
-        (y == 0 || z == 0 || y == g->size_y - 1 || z == g->size_z - 1)) {
-        for (x = 0; x < g->size_x; x++)
-            RHS[x] = g->bc->value;
-        return;
-    }
 
     if (g->size_y > 1) {
         yp = (y == g->size_y - 1) ? y - 1 : y + 1;
@@ -1088,7 +1088,7 @@ static void ecs_dg_adi_x(ECS_Grid_node* g,
         if (g->size_x > 1) {
             RHS[0] += dt * (g->dc_x / SQ(g->dx)) * (state[IDX(1, y, z)] - state[IDX(0, y, z)]);
             x = g->size_x - 1;
-            RHS[x] =
+            RHS[x * stride] =
                 state[IDX(x, y, z)] + g->states_cur[IDX(x, y, z)] +
                 dt * ((g->dc_x / SQ(g->dx)) * (state[IDX(x - 1, y, z)] - state[IDX(x, y, z)]) +
                       (g->dc_y / SQ(g->dy)) *
@@ -1100,7 +1100,7 @@ static void ecs_dg_adi_x(ECS_Grid_node* g,
         }
     } else {
         RHS[0] = g->bc->value;
-        RHS[g->size_x - 1] = g->bc->value;
+        RHS[(g->size_x - 1) * stride] = g->bc->value;
     }
     for (x = 1; x < g->size_x - 1; x++) {
 #ifndef __PGI
@@ -1108,20 +1108,42 @@ static void ecs_dg_adi_x(ECS_Grid_node* g,
         __builtin_prefetch(&(state[IDX(x + PREFETCH, yp, z)]), 0, 0);
         __builtin_prefetch(&(state[IDX(x + PREFETCH, ym, z)]), 0, 0);
 #endif
-        RHS[x] = state[IDX(x, y, z)] +
-                 dt *
-                     ((g->dc_x / SQ(g->dx)) *
-                          (state[IDX(x + 1, y, z)] - 2. * state[IDX(x, y, z)] +
-                           state[IDX(x - 1, y, z)]) /
-                          2. +
-                      (g->dc_y / SQ(g->dy)) *
-                          (state[IDX(x, yp, z)] - 2. * state[IDX(x, y, z)] + state[IDX(x, ym, z)]) /
-                          div_y +
-                      (g->dc_z / SQ(g->dz)) *
-                          (state[IDX(x, y, zp)] - 2. * state[IDX(x, y, z)] + state[IDX(x, y, zm)]) /
-                          div_z) +
-                 g->states_cur[IDX(x, y, z)];
+        RHS[x * stride] =
+            state[IDX(x, y, z)] +
+            dt * ((g->dc_x / SQ(g->dx)) *
+                      (state[IDX(x + 1, y, z)] - 2. * state[IDX(x, y, z)] +
+                       state[IDX(x - 1, y, z)]) /
+                      2. +
+                  (g->dc_y / SQ(g->dy)) *
+                      (state[IDX(x, yp, z)] - 2. * state[IDX(x, y, z)] + state[IDX(x, ym, z)]) /
+                      div_y +
+                  (g->dc_z / SQ(g->dz)) *
+                      (state[IDX(x, y, zp)] - 2. * state[IDX(x, y, z)] + state[IDX(x, y, zm)]) /
+                      div_z) +
+            g->states_cur[IDX(x, y, z)];
+    }
+}
+
+/* dg_adi_x performs the first of 3 steps in DG-ADI
+ * g    -   the parameters and state of the grid
+ * dt   -   the time step
+ * y    -   the index for the y plane
+ * z    -   the index for the z plane
+ * state    -   where the output of this step is stored
+ * scratch  - scratchpad array of doubles, length g->size_x - 1
+ */
+static void ecs_dg_adi_x(ECS_Grid_node* g,
+                         const double dt,
+                         const int y,
+                         const int z,
+                         double const* const state,
+                         double* const RHS,
+                         double* const scratch) {
+    double r = g->dc_x * dt / SQ(g->dx);
+    if (ecs_dirichlet_boundary_line(g, y, z, g->size_y, g->size_z, g->size_x, RHS)) {
+        return;
     }
+    ecs_dg_adi_rhs_x(g, dt, y, z, state, RHS, 1);
     if (g->size_x > 1) {
         if (g->bc->type == NEUMANN)
             solve_dd_clhs_tridiag(g->size_x,
@@ -1141,6 +1163,48 @@ static void ecs_dg_adi_x(ECS_Grid_node* g,
 }
 
 
+/* ecs_dg_adi_rhs_y computes the right hand side of the second of 3 steps in
+ * DG-ADI for the line at x, z, g->size_y > 1. Element y is stored in
+ * RHS[y * stride].
+ */
+static void ecs_dg_adi_rhs_y(ECS_Grid_node* g,
+                             double const dt,
+                             int const x,
+                             int const z,
+                             double const* const state,
+                             double* const RHS,
+                             const int stride) {
+    int y;
+    if (g->bc->type == NEUMANN) {
+        /*zero flux boundary condition*/
+        RHS[0] = state[x + z * g->size_x] -
+                 (g->dc_y * dt / SQ(g->dy)) *
+                     (g->states[IDX(x, 1, z)] - 2.0 * g->states[IDX(x, 0, z)] +
+                      g->states[IDX(x, 1, z)]) /
+                     4.0;
+        y = g->size_y - 1;
+        RHS[y * stride] = state[x + (z + y * g->size_z) * g->size_x] -
+                          (g->dc_y * dt / SQ(g->dy)) *
+                              (g->states[IDX(x, y - 1, z)] - 2. * g->states[IDX(x, y, z)] +
+                               g->states[IDX(x, y - 1, z)]) /
+                              4.0;
+    } else {
+        RHS[0] = g->bc->value;
+        RHS[(g->size_y - 1) * stride] = g->bc->value;
+    }
+    for (y = 1; y < g->size_y - 1; y++) {
+#ifndef __PGI
+        __builtin_prefetch(&state[x + (z + (y + PREFETCH) * g->size_z) * g->size_x], 0, 0);
+        __builtin_prefetch(&(g->states[IDX(x, y + PREFETCH, z)]), 0, 1);
+#endif
+        RHS[y * stride] = state[x + (z + y * g->size_z) * g->size_x] -
+                          (g->dc_y * dt / SQ(g->dy)) *
+                              (g->states[IDX(x, y + 1, z)] - 2. * g->states[IDX(x, y, z)] +
+                               g->states[IDX(x, y - 1, z)]) /
+                              2.0;
+    }
+}
+
 /* dg_adi_y performs the second of 3 steps in DG-ADI
  * g    -   the parameters and state of the grid
  * dt   -   the time step
@@ -1157,13 +1221,8 @@ static void ecs_dg_adi_y(ECS_Grid_node* g,
                          double const* const state,
                          double* const RHS,
                          double* const scratch) {
-    int y;
     double r = (g->dc_y * dt / SQ(g->dy));
-    /*TODO: Get rid of this by not calling dg_adi when on the boundary for DIRICHLET conditions*/
-    if (g->bc->type == DIRICHLET &&
-        (x == 0 || z == 0 || x == g->size_x - 1 || z == g->size_z - 1)) {
-        for (y = 0; y < g->size_y; y++)
-            RHS[y] = g->bc->value;
+    if (ecs_dirichlet_boundary_line(g, x, z, g->size_x, g->size_z, g->size_y, RHS)) {
         return;
     }
     if (g->size_y == 1) {
@@ -1173,34 +1232,7 @@ static void ecs_dg_adi_y(ECS_Grid_node* g,
             RHS[0] = g->bc->value;
         return;
     }
-    if (g->bc->type == NEUMANN) {
-        /*zero flux boundary condition*/
-        RHS[0] = state[x + z * g->size_x] -
-                 (g->dc_y * dt / SQ(g->dy)) *
-                     (g->states[IDX(x, 1, z)] - 2.0 * g->states[IDX(x, 0, z)] +
-                      g->states[IDX(x, 1, z)]) /
-                     4.0;
-        y = g->size_y - 1;
-        RHS[y] = state[x + (z + y * g->size_z) * g->size_x] -
-                 (g->dc_y * dt / SQ(g->dy)) *
-                     (g->states[IDX(x, y - 1, z)] - 2. * g->states[IDX(x, y, z)] +
-                      g->states[IDX(x, y - 1, z)]) /
-                     4.0;
-    } else {
-        RHS[0] = g->bc->value;
-        RHS[g->size_y - 1] = g->bc->value;
-    }
-    for (y = 1; y < g->size_y - 1; y++) {
-#ifndef __PGI
-        __builtin_prefetch(&state[x + (z + (y + PREFETCH) * g->size_z) * g->size_x], 0, 0);
-        __builtin_prefetch(&(g->states[IDX(x, y + PREFETCH, z)]), 0, 1);
-#endif
-        RHS[y] = state[x + (z + y * g->size_z) * g->size_x] -
-                 (g->dc_y * dt / SQ(g->dy)) *
-                     (g->states[IDX(x, y + 1, z)] - 2. * g->states[IDX(x, y, z)] +
-                      g->states[IDX(x, y - 1, z)]) /
-                     2.0;
-    }
+    ecs_dg_adi_rhs_y(g, dt, x, z, state, RHS, 1);
     if (g->bc->type == NEUMANN)
         solve_dd_clhs_tridiag(g->size_y,
                               -r / 2.0,
@@ -1217,6 +1249,44 @@ static void ecs_dg_adi_y(ECS_Grid_node* g,
 }
 
 
+/* ecs_dg_adi_rhs_z computes the right hand side of the final step in DG-ADI
+ * for the line at x, y, g->size_z > 1. Element z is stored in RHS[z * stride].
+ */
+static void ecs_dg_adi_rhs_z(ECS_Grid_node* g,
+                             double const dt,
+                             int const x,
+                             int const y,
+                             double const* const state,
+                             double* const RHS,
+                             const int stride) {
+    int z;
+    if (g->bc->type == NEUMANN) {
+        /*zero flux boundary condition*/
+        RHS[0] = state[y + g->size_y * (x * g->size_z)] -
+                 (g->dc_z * dt / SQ(g->dz)) *
+                     (g->states[IDX(x, y, 1)] - 2.0 * g->states[IDX(x, y, 0)] +
+                      g->states[IDX(x, y, 1)]) /
+                     4.0;
+        z = g->size_z - 1;
+        RHS[z * stride] = state[y + g->size_y * (x * g->size_z + z)] -
+                          (g->dc_z * dt / SQ(g->dz)) *
+                              (g->states[IDX(x, y, z - 1)] - 2.0 * g->states[IDX(x, y, z)] +
+                               g->states[IDX(x, y, z - 1)]) /
+                              4.0;
+
+    } else {
+        RHS[0] = g->bc->value;
+        RHS[(g->size_z - 1) * stride] = g->bc->value;
+    }
+    for (z = 1; z < g->size_z - 1; z++) {
+        RHS[z * stride] = state[y + g->size_y * (x * g->size_z + z)] -
+                          (g->dc_z * dt / SQ(g->dz)) *
+                              (g->states[IDX(x, y, z + 1)] - 2. * g->states[IDX(x, y, z)] +
+                               g->states[IDX(x, y, z - 1)]) /
+                              2.;
+    }
+}
+
 /* dg_adi_z performs the final step in DG-ADI
  * g    -   the parameters and state of the grid
  * dt   -   the time step
@@ -1233,13 +1303,8 @@ static void ecs_dg_adi_z(ECS_Grid_node* g,
                          double const* const state,
                          double* const RHS,
                          double* const scratch) {
-    int z;
     double r = g->dc_z * dt / SQ(g->dz);
-    /*TODO: Get rid of this by not calling dg_adi when on the boundary for DIRICHLET conditions*/
-    if (g->bc->type == DIRICHLET &&
-        (x == 0 || y == 0 || x == g->size_x - 1 || y == g->size_y - 1)) {
-        for (z = 0; z < g->size_z; z++)
-            RHS[z] = g->bc->value;
+    if (ecs_dirichlet_boundary_line(g, x, y, g->size_x, g->size_y, g->size_z, RHS)) {
         return;
     }
 
@@ -1250,32 +1315,7 @@ static void ecs_dg_adi_z(ECS_Grid_node* g,
             RHS[0] = g->bc->value;
         return;
     }
-
-    if (g->bc->type == NEUMANN) {
-        /*zero flux boundary condition*/
-        RHS[0] = state[y + g->size_y * (x * g->size_z)] -
-                 (g->dc_z * dt / SQ(g->dz)) *
-                     (g->states[IDX(x, y, 1)] - 2.0 * g->states[IDX(x, y, 0)] +
-                      g->states[IDX(x, y, 1)]) /
-                     4.0;
-        z = g->size_z - 1;
-        RHS[z] = state[y + g->size_y * (x * g->size_z + z)] -
-                 (g->dc_z * dt / SQ(g->dz)) *
-                     (g->states[IDX(x, y, z - 1)] - 2.0 * g->states[IDX(x, y, z)] +
-                      g->states[IDX(x, y, z - 1)]) /
-                     4.0;
-
-    } else {
-        RHS[0] = g->bc->value;
-        RHS[g->size_z - 1] = g->bc->value;
-    }
-    for (z = 1; z < g->size_z - 1; z++) {
-        RHS[z] = state[y + g->size_y * (x * g->size_z + z)] -
-                 (g->dc_z * dt / SQ(g->dz)) *
-                     (g->states[IDX(x, y, z + 1)] - 2. * g->states[IDX(x, y, z)] +
-                      g->states[IDX(x, y, z - 1)]) /
-                     2.;
-    }
+    ecs_dg_adi_rhs_z(g, dt, x, y, state, RHS, 1);
 
     if (g->bc->type == NEUMANN)
         solve_dd_clhs_tridiag(g->size_z,
@@ -1292,6 +1332,69 @@ static void ecs_dg_adi_z(ECS_Grid_node* g,
         solve_dd_clhs_tridiag(g->size_z, -r / 2., 1. + r, -r / 2., 1.0, 0, 0, 1.0, RHS, scratch);
 }
 
+/* ecs_dg_adi_lanes performs a homogeneous DG-ADI step for the lines
+ * [start, stop) ECS_ADI_LANES at a time. The right hand sides of a tile of
+ * lines are assembled interleaved in the scratchpad and solved together with
+ * the matrix factored once for all lines. The results are the same as with
+ * ecs_dg_adi_x, ecs_dg_adi_y or ecs_dg_adi_z for each line.
+ */
+static void ecs_dg_adi_lanes(ECS_Grid_node* g,
+                             ECSAdiDirection* ecs_adi_dir,
+                             const double dt,
+                             const int start,
+                             const int stop,
+                             const int sizej,
+                             double* const scratchpad) {
+    int k, l, n;
+    const int N = ecs_adi_dir->line_size;
+    const int sizei = g->size_x * g->size_y * g->size_z / N / sizej;
+    double const* const state_in = ecs_adi_dir->states_in;
+    double* const state_out = ecs_adi_dir->states_out;
+    double* const c = scratchpad;
+    double* const den = scratchpad + N;
+    double* const tile = scratchpad + 2 * N;
+    double r;
+    if (ecs_adi_dir == g->ecs_adi_dir_x) {
+        r = g->dc_x * dt / SQ(g->dx);
+    } else if (ecs_adi_dir == g->ecs_adi_dir_y) {
+        r = g->dc_y * dt / SQ(g->dy);
+    } else {
+        r = g->dc_z * dt / SQ(g->dz);
+    }
+    const unsigned char neumann = g->bc->type == NEUMANN;
+    if (neumann)
+        factor_dd_clhs_tridiag(N,
+                               -r / 2.0,
+                               1.0 + r,
+                               -r / 2.0,
+                               1.0 + r / 2.0,
+                               -r / 2.0,
+                               -r / 2.0,
+                               1.0 + r / 2.0,
+                               c,
+                               den);
+    else
+        factor_dd_clhs_tridiag(N, -r / 2.0, 1.0 + r, -r / 2.0, 1.0, 0, 0, 1.0, c, den);
+
+    for (k = start; k < stop; k += ECS_ADI_LANES) {
+        const int nlane = MIN(ECS_ADI_LANES, stop - k);
+        for (l = 0; l < nlane; l++) {
+            ecs_adi_dir->ecs_dg_adi_rhs(
+                g, dt, (k + l) / sizej, (k + l) % sizej, state_in, tile + l, nlane);
+        }
+        solve_dd_clhs_tridiag_lanes(N, nlane, -r / 2.0, neumann ? -r / 2.0 : 0, c, den, tile);
+        for (l = 0; l < nlane; l++) {
+            const int i = (k + l) / sizej;
+            const int j = (k + l) % sizej;
+            double* const out = &state_out[(k + l) * N];
+            if (!ecs_dirichlet_boundary_line(g, i, j, sizei, sizej, N, out)) {
+                for (n = 0; n < N; n++)
+                    out[n] = tile[n * nlane + l];
+            }
+        }
+    }
+}
+
 static void* ecs_do_dg_adi(void* dataptr) {
     ECSAdiGridData* data = (ECSAdiGridData*) dataptr;
     int start = data->start;
@@ -1308,6 +1411,10 @@ static void* ecs_do_dg_adi(void* dataptr) {
     void (*ecs_dg_adi_dir)(
         ECS_Grid_node*, double, int, int, double const* const, double* const, double* const) =
         ecs_adi_dir->ecs_dg_adi_dir;
+    if (ecs_adi_dir->ecs_dg_adi_rhs && offset > 1) {
+        ecs_dg_adi_lanes(g, ecs_adi_dir, dt, start, stop, sizej, scratchpad);
+        return NULL;
+    }
     for (k = start; k < stop; k++) {
         i = k / sizej;
         j = k % sizej;
@@ -1339,18 +1446,14 @@ void ecs_run_threaded_dg_adi(const int i,
         g->ecs_tasks[k].ecs_adi_dir = ecs_adi_dir;
     }
     g->ecs_tasks[NUM_THREADS - 1].stop = i * j;
-    /* launch threads */
-    for (k = 0; k < NUM_THREADS - 1; k++) {
-        TaskQueue_add_task(AllTasks, &ecs_do_dg_adi, &(g->ecs_tasks[k]), NULL);
-    }
-    /* run one task in the main thread */
-    ecs_do_dg_adi(&(g->ecs_tasks[NUM_THREADS - 1]));
-    /* wait for them to finish */
-    TaskQueue_sync(AllTasks);
+    nrn_multitask(NUM_THREADS, &ecs_do_dg_adi, g->ecs_tasks);
 }
 
 void ecs_set_adi_homogeneous(ECS_Grid_node* g) {
     g->ecs_adi_dir_x->ecs_dg_adi_dir = ecs_dg_adi_x;
     g->ecs_adi_dir_y->ecs_dg_adi_dir = ecs_dg_adi_y;
     g->ecs_adi_dir_z->ecs_dg_adi_dir = ecs_dg_adi_z;
+    g->ecs_adi_dir_x->ecs_dg_adi_rhs = ecs_dg_adi_rhs_x;
+    g->ecs_adi_dir_y->ecs_dg_adi_rhs = ecs_dg_adi_rhs_y;
+    g->ecs_adi_dir_z->ecs_dg_adi_rhs = ecs_dg_adi_rhs_z;
 }
@@ -4,6 +4,7 @@
 #include <string.h>
 #include "grids.h"
 #include "rxd.h"
+#include <../nrnoc/multicore.h>
 #include "nrnwrap_Python.h"
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
@@ -12,7 +13,6 @@
 #include <cmath>
 
 extern int NUM_THREADS;
-extern TaskQueue* AllTasks;
 extern double* states;
 
 /*
@@ -283,14 +283,7 @@ void run_threaded_deltas(ICS_Grid_node* g, ICSAdiDirection* ics_adi_dir) {
                                                                // index is just i
         g->ics_tasks[i].ics_adi_dir = ics_adi_dir;
     }
-    /* launch threads */
-    for (i = 0; i < NUM_THREADS - 1; i++) {
-        TaskQueue_add_task(AllTasks, &do_ics_deltas, &(g->ics_tasks[i]), NULL);
-    }
-    /* run one task in the main thread */
-    do_ics_deltas(&(g->ics_tasks[NUM_THREADS - 1]));
-    /* wait for them to finish */
-    TaskQueue_sync(AllTasks);
+    nrn_multitask(NUM_THREADS, &do_ics_deltas, g->ics_tasks);
 }
 
 // Inhomogeneous diffusion coefficient
@@ -783,14 +776,7 @@ void ICS_Grid_node::run_threaded_ics_dg_adi(ICSAdiDirection* ics_adi_dir) {
                                                                // index is just i
         ics_tasks[i].ics_adi_dir = ics_adi_dir;
     }
-    /* launch threads */
-    for (i = 0; i < NUM_THREADS - 1; i++) {
-        TaskQueue_add_task(AllTasks, &do_ics_dg_adi, &ics_tasks[i], NULL);
-    }
-    /* run one task in the main thread */
-    do_ics_dg_adi(&ics_tasks[NUM_THREADS - 1]);
-    /* wait for them to finish */
-    TaskQueue_sync(AllTasks);
+    nrn_multitask(NUM_THREADS, &do_ics_dg_adi, ics_tasks);
 }
 
 
@@ -0,0 +1,77 @@
+#pragma once
+/* Thomas algorithm for many independent tridiagonal lines that share the same
+ * constant coefficient, diagonally dominant matrix, as in the homogeneous
+ * extracellular DG-ADI steps. The factorization depends only on the matrix so
+ * it is done once per direction per step. The lines are solved together,
+ * interleaved so that element i of line l is b[i * nlane + l], which makes the
+ * loop over lines the innermost loop and lets it vectorize regardless of
+ * the direction of the lines in the grid.
+ *
+ * The arithmetic is the same as solve_dd_clhs_tridiag, so results are
+ * identical to solving one line at a time.
+ */
+
+/* number of lines solved together; a tile of lines is
+ * ECS_ADI_LANES * line length doubles */
+#define ECS_ADI_LANES 16
+
+/* factor_dd_clhs_tridiag computes the upper multipliers c (length N - 1) and
+ * the pivots den (length N) of the matrix described in solve_dd_clhs_tridiag.
+ */
+static inline void factor_dd_clhs_tridiag(const int N,
+                                          const double l_diag,
+                                          const double diag,
+                                          const double u_diag,
+                                          const double lbc_diag,
+                                          const double lbc_u_diag,
+                                          const double ubc_l_diag,
+                                          const double ubc_diag,
+                                          double* const c,
+                                          double* const den) {
+    int i;
+    den[0] = lbc_diag;
+    c[0] = lbc_u_diag / lbc_diag;
+    for (i = 1; i < N - 1; i++) {
+        den[i] = diag - l_diag * c[i - 1];
+        c[i] = u_diag / den[i];
+    }
+    den[N - 1] = ubc_diag - ubc_l_diag * c[N - 2];
+}
+
+/* solve_dd_clhs_tridiag_lanes solves nlane interleaved lines of length N,
+ * N > 1, in place given the factorization from factor_dd_clhs_tridiag.
+ */
+static inline void solve_dd_clhs_tridiag_lanes(const int N,
+                                               const int nlane,
+                                               const double l_diag,
+                                               const double ubc_l_diag,
+                                               double const* const c,
+                                               double const* const den,
+                                               double* const b) {
+    int i, l;
+    for (l = 0; l < nlane; l++) {
+        b[l] = b[l] / den[0];
+    }
+    for (i = 1; i < N - 1; i++) {
+        double* const bi = b + i * nlane;
+        double const* const bm = bi - nlane;
+        for (l = 0; l < nlane; l++) {
+            bi[l] = (bi[l] - l_diag * bm[l]) / den[i];
+        }
+    }
+    {
+        double* const bi = b + (N - 1) * nlane;
+        double const* const bm = bi - nlane;
+        for (l = 0; l < nlane; l++) {
+            bi[l] = (bi[l] - ubc_l_diag * bm[l]) / den[N - 1];
+        }
+    }
+    /*back substitution*/
+    for (i = N - 2; i >= 0; i--) {
+        double* const bi = b + i * nlane;
+        double const* const bp = bi + nlane;
+        for (l = 0; l < nlane; l++) {
+            bi[l] = bi[l] - c[i] * bp[l];
+        }
+    }
+}
@@ -411,6 +411,9 @@ void ecs_set_adi_vol(ECS_Grid_node* g) {
     g->ecs_adi_dir_x->ecs_dg_adi_dir = ecs_dg_adi_vol_x;
     g->ecs_adi_dir_y->ecs_dg_adi_dir = ecs_dg_adi_vol_y;
     g->ecs_adi_dir_z->ecs_dg_adi_dir = ecs_dg_adi_vol_z;
+    g->ecs_adi_dir_x->ecs_dg_adi_rhs = NULL;
+    g->ecs_adi_dir_y->ecs_dg_adi_rhs = NULL;
+    g->ecs_adi_dir_z->ecs_dg_adi_rhs = NULL;
 }
 
 
@@ -773,6 +776,9 @@ void ecs_set_adi_tort(ECS_Grid_node* g) {
     g->ecs_adi_dir_x->ecs_dg_adi_dir = ecs_dg_adi_tort_x;
     g->ecs_adi_dir_y->ecs_dg_adi_dir = ecs_dg_adi_tort_y;
     g->ecs_adi_dir_z->ecs_dg_adi_dir = ecs_dg_adi_tort_z;
+    g->ecs_adi_dir_x->ecs_dg_adi_rhs = NULL;
+    g->ecs_adi_dir_y->ecs_dg_adi_rhs = NULL;
+    g->ecs_adi_dir_z->ecs_dg_adi_rhs = NULL;
 }
 
 
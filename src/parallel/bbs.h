@@ -62,7 +62,7 @@ class BBS {
     Object** gid2cell(int);
     Object** gid_connect(int);
     double netpar_mindelay(double maxdelay);
-    void netpar_spanning_statistics(int*, int*, int*, int*);
+    void netpar_spanning_statistics(int*, int*, int*, int*, int*);
     IvocVect* netpar_max_histogram(IvocVect*);
     Object** pyret();
 
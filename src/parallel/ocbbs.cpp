@@ -9,11 +9,13 @@
 #include "section.h"
 #include "membfunc.h"
 #include "multicore.h"
+#include "nrn_phase_time.h"
 #include "nrnpy.h"
 #include "utils/profile/profiler_interface.h"
 #include "node_order_optim/node_order_optim.h"
 #include <nrnmpi.h>
 #include <cerrno>
+#include <cstring>
 
 #undef MD
 #define MD 2147483647.
@@ -478,6 +480,44 @@ static double mech_time(void* v) {
     return 0;
 }
 
+static double phase_time(void* v) {
+    if (!ifarg(1)) {
+        nrn_phase_time_enable(true);
+        return 0;
+    }
+    if (!ifarg(2)) {
+        if (*getarg(1) != -1.) {
+            hoc_execerror("phase_time", "a single argument must be -1");
+        }
+        nrn_phase_time_enable(false);
+        return 0;
+    }
+    int ith = int(chkarg(1, 0, nrn_nthread - 1));
+    const char* name = hoc_gargstr(2);
+    if (ifarg(3)) {
+        bool state = strcmp(name, "state") == 0;
+        if (!state && strcmp(name, "cur") != 0) {
+            hoc_execerror(name, "is not \"cur\" or \"state\"");
+        }
+        int type;
+        if (hoc_is_str_arg(3)) {
+            Symbol* sym = hoc_lookup(hoc_gargstr(3));
+            if (!sym || sym->type != MECHANISM) {
+                hoc_execerror(hoc_gargstr(3), "is not a mechanism");
+            }
+            type = sym->subtype;
+        } else {
+            type = int(chkarg(3, 0, n_memb_func - 1));
+        }
+        return nrn_phase_mech_time(ith, type, state);
+    }
+    int phase = nrn_phase_lookup(name);
+    if (phase < 0) {
+        hoc_execerror(name, "is not a phase name");
+    }
+    return nrn_phase_time(ith, phase);
+}
+
 static double prcellstate(void* v) {
     nrn_prcellstate(int(*hoc_getarg(1)), hoc_gargstr(2));
     return 0;
@@ -659,10 +699,10 @@ static double set_maxstep(void* v) {
 
 static double spike_stat(void* v) {
     OcBBS* bbs = (OcBBS*) v;
-    int nsend, nsendmax, nrecv, nrecv_useful;
+    int nsend, nsendmax, nrecv, nrecv_useful, nexchange;
     hoc_return_type_code = 1;  // integer
-    nsend = nsendmax = nrecv = nrecv_useful = 0;
-    bbs->netpar_spanning_statistics(&nsend, &nsendmax, &nrecv, &nrecv_useful);
+    nsend = nsendmax = nrecv = nrecv_useful = nexchange = 0;
+    bbs->netpar_spanning_statistics(&nsend, &nsendmax, &nrecv, &nrecv_useful, &nexchange);
     if (ifarg(1)) {
         *hoc_pgetarg(1) = nsend;
     }
@@ -672,6 +712,9 @@ static double spike_stat(void* v) {
     if (ifarg(3)) {
         *hoc_pgetarg(3) = nrecv_useful;
     }
+    if (ifarg(4)) {
+        *hoc_pgetarg(4) = nexchange;
+    }
     return double(nsendmax);
 }
 
@@ -878,6 +921,14 @@ static double nthrd(void*) {
     return double(nrn_nthread);
 }
 
+static double thread_dynamic(void*) {
+    hoc_return_type_code = 1;  // integer
+    if (ifarg(1)) {
+        nrn_thread_dynamic(int(chkarg(1, 0, 1e5)));
+    }
+    return double(nrn_thread_dynamic());
+}
+
 static double number_of_worker_threads(void*) {
     hoc_return_type_code = 1;  // integer
     return nof_worker_threads();
@@ -1053,6 +1104,7 @@ static Member_func members[] = {{"submit", submit},
                                 {"integ_time", integ_time},
                                 {"vtransfer_time", vtransfer_time},
                                 {"mech_time", mech_time},
+                                {"phase_time", phase_time},
                                 {"timeout", set_timeout},
                                 {"mpiabort_on_error", set_mpiabort_on_error},
 
@@ -1084,6 +1136,7 @@ static Member_func members[] = {{"submit", submit},
 
                                 {"nthread", nthrd},
                                 {"nworker", number_of_worker_threads},
+                                {"thread_dynamic", thread_dynamic},
                                 {"partition", partition},
                                 {"thread_stat", thread_stat},
                                 {"thread_busywait", thread_busywait},
@@ -142,6 +142,7 @@ char* spCreate(int Size, BOOLEAN Complex, int* pError)
 
     /* Initialize matrix */
     Matrix->ID = SPARSE_ID;
+    Matrix->Compiled = NULL;
     Matrix->Complex = Complex;
     Matrix->PreviousMatrixWasComplex = Complex;
     Matrix->Factored = NO;
@@ -552,6 +553,7 @@ void spDestroy(char* eMatrix)
     FREE(Matrix->DoCmplxDirect);
     FREE(Matrix->DoRealDirect);
     FREE(Matrix->Intermediate);
+    delete Matrix->Compiled;
 
     /* Sequentially step through the list of allocated pointers freeing pointers
      * along the way. */
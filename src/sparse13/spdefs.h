@@ -169,6 +169,7 @@
  */
 #include "spmatrix.h"
 #include <stdlib.h>
+#include <vector>
 
 #define ALLOC(type, number) ((type*)malloc((unsigned)(sizeof(type) * (number))))
 #define REALLOC(ptr, type, number) \
@@ -298,6 +299,57 @@ typedef struct AllocationRecord* AllocationListPtr;
  *      Pointer to the next fill-in list structures.
  */
 
+/*
+ *  COMPILED FACTORIZATION SCHEDULE
+ *
+ *  Once a real matrix has been ordered, the sequence of operations done by
+ *  spFactor() and spSolve() depends only on the structure of the matrix.
+ *  The CompiledFactor holds that sequence as flat arrays of pointers to the
+ *  Real fields of the elements, so that refactorization and solution walk
+ *  contiguous arrays instead of the linked lists.  The arithmetic, and its
+ *  order, is the same as that of the indirect addressing path of spFactor()
+ *  and of spSolve().  Indices into the arrays are given by the End arrays:
+ *  the entries for step k are [End[k-1], End[k]).
+ *
+ *  >>> Structure fields:
+ *  Elements  (int)
+ *      Matrix->Elements when the schedule was built.
+ *  Diag  (RealNumber *[])
+ *      Diag[k] points to the pivot of step k, 1 <= k <= Size.
+ *  StepEnd  (int [])
+ *      Per step, range of the column entries above the diagonal.
+ *  Upper, UpperPivot  (RealNumber *[])
+ *      Per column entry above the diagonal, the entry and the pivot of its
+ *      row.
+ *  UpperEnd  (int [])
+ *      Per column entry above the diagonal, range of its updates.
+ *  UpdateDest, UpdateSrc  (RealNumber *[])
+ *      Per update, the element of the current column and the element of
+ *      the pivot column below the diagonal that multiplies the entry.
+ *  LowerEnd, LowerRow, LowerVal
+ *      Per column, the row and value of the elements below the diagonal.
+ *  RowEnd, RowCol, RowVal
+ *      Per row, the column and value of the elements right of the diagonal.
+ */
+
+/* Begin `CompiledFactor'. */
+struct CompiledFactor {
+    int Elements;
+    std::vector<RealNumber*> Diag;
+    std::vector<int> StepEnd;
+    std::vector<RealNumber*> Upper;
+    std::vector<RealNumber*> UpperPivot;
+    std::vector<int> UpperEnd;
+    std::vector<RealNumber*> UpdateDest;
+    std::vector<RealNumber*> UpdateSrc;
+    std::vector<int> LowerEnd;
+    std::vector<int> LowerRow;
+    std::vector<RealNumber*> LowerVal;
+    std::vector<int> RowEnd;
+    std::vector<int> RowCol;
+    std::vector<RealNumber*> RowVal;
+};
+
 /* Begin `FillinListNodeStruct'. */
 struct FillinListNodeStruct {
     ElementPtr pFillinList;
@@ -329,6 +381,10 @@ struct FillinListNodeStruct {
  *      grow to when EXPANDABLE is set true and AllocatedSize is the largest
  *      the matrix can get without requiring that the matrix frame be
  *      reallocated.
+ *  Compiled  (struct CompiledFactor *)
+ *      Flat elimination schedule of the current ordering, built on demand
+ *      by spFactorCompiled().  NULL if not built or if the ordering has
+ *      changed since.
  *  Complex  (BOOLEAN)
  *      The flag which indicates whether the matrix is complex (true) or
  *      real.
@@ -498,6 +554,7 @@ struct MatrixFrame {
     RealNumber AbsThreshold;
     int AllocatedSize;
     int AllocatedExtSize;
+    struct CompiledFactor* Compiled;
     BOOLEAN Complex;
     int CurrentSize;
     ArrayOfElementPtrs Diag;
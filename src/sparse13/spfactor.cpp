@@ -78,6 +78,7 @@ static void RealRowColElimination(MatrixPtr Matrix, ElementPtr pPivot);
 static void UpdateMarkowitzNumbers(MatrixPtr Matrix, ElementPtr pPivot);
 static ElementPtr CreateFillin(MatrixPtr Matrix, int Row, int Col);
 static int MatrixIsSingular(MatrixPtr Matrix, int Step);
+static BOOLEAN CompileFactor(MatrixPtr Matrix);
 static int ZeroPivot(MatrixPtr Matrix, int Step);
 
 ElementPtr spcFindElementInCol(MatrixPtr Matrix, ElementPtr* LastAddr, int Row, int Col, BOOLEAN CreateIfMissing);
@@ -242,6 +243,10 @@ int spOrderAndFactor(char* eMatrix, RealNumber* RHS, RealNumber RelThreshold, Re
             return Matrix->Error;
     }
 
+    /* The ordering is about to change, so any compiled schedule is stale. */
+    delete Matrix->Compiled;
+    Matrix->Compiled = NULL;
+
     /* Form initial Markowitz products. */
     CountMarkowitz(Matrix, RHS, Step);
     MarkowitzProducts(Matrix, Step);
@@ -394,6 +399,180 @@ int spFactor(char* eMatrix)
 #endif /* REAL */
 }
 
+/*
+ *  FACTOR MATRIX USING A COMPILED SCHEDULE
+ *
+ *  This routine is a replacement for spFactor() for matrices that are
+ *  refactored many times with the same structure, such as the tree
+ *  matrix of a cell with extracellular or linear mechanisms.  The first
+ *  time it is called after the matrix has been ordered, the elimination
+ *  operations of the indirect addressing path of spFactor() are
+ *  recorded as flat arrays of element pointers (see CompiledFactor in
+ *  spdefs.h).  Later calls replay those arrays, which avoids the walk
+ *  along the linked lists and the scatter into Intermediate.  The
+ *  operations, and their order, are the same as those of spFactor(),
+ *  so the factors are the same.  If the matrix needs ordering, or its
+ *  structure has changed since the schedule was recorded, spFactor()
+ *  is used and the schedule is rebuilt on the next call.
+ *
+ *  >>> Returned:
+ *  The error code is returned.  Possible errors are those of spFactor().
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (char *)
+ *      Pointer to matrix.
+ */
+
+int spFactorCompiled(char* eMatrix)
+{
+    MatrixPtr Matrix = (MatrixPtr)eMatrix;
+    struct CompiledFactor* pCompiled;
+    RealNumber *const* Diag;
+    RealNumber *const* Upper;
+    RealNumber *const* UpperPivot;
+    RealNumber *const* UpdateDest;
+    RealNumber *const* UpdateSrc;
+    const int *StepEnd, *UpperEnd;
+    int Step, Size, I, J;
+    RealNumber Mult;
+
+    /* Begin `spFactorCompiled'. */
+    ASSERT(IS_VALID(Matrix) AND NOT Matrix->Factored);
+
+    if (Matrix->NeedsOrdering)
+        return spFactor(eMatrix);
+    pCompiled = Matrix->Compiled;
+    if (pCompiled == NULL OR pCompiled->Elements != Matrix->Elements) {
+        if (NOT CompileFactor(Matrix))
+            return spFactor(eMatrix);
+        pCompiled = Matrix->Compiled;
+    }
+
+    Size = Matrix->Size;
+    Diag = pCompiled->Diag.data();
+    StepEnd = pCompiled->StepEnd.data();
+    Upper = pCompiled->Upper.data();
+    UpperPivot = pCompiled->UpperPivot.data();
+    UpperEnd = pCompiled->UpperEnd.data();
+    UpdateDest = pCompiled->UpdateDest.data();
+    UpdateSrc = pCompiled->UpdateSrc.data();
+
+    if (*Diag[1] == 0.0)
+        return ZeroPivot(Matrix, 1);
+    *Diag[1] = 1.0 / *Diag[1];
+
+    I = StepEnd[1];
+    J = UpperEnd[I - 1];
+    for (Step = 2; Step <= Size; Step++) {
+        for (; I < StepEnd[Step]; I++) {
+            Mult = (*Upper[I] *= *UpperPivot[I]);
+            for (; J < UpperEnd[I]; J++)
+                *UpdateDest[J] -= Mult * *UpdateSrc[J];
+        }
+
+        /* Check for singular matrix. */
+        if (*Diag[Step] == 0.0)
+            return ZeroPivot(Matrix, Step);
+        *Diag[Step] = 1.0 / *Diag[Step];
+    }
+
+    Matrix->Factored = YES;
+    return (Matrix->Error = spOKAY);
+}
+
+/*
+ *  COMPILE FACTORIZATION SCHEDULE
+ *
+ *  Records, in Matrix->Compiled, the operations done by spFactor() and
+ *  spSolve() for the present ordering.  Indices into the Upper and
+ *  Update arrays start at 1 so that StepEnd[0] and UpperEnd[0] can
+ *  mark the beginning.
+ *
+ *  >>> Returned:
+ *  NO if an update has no destination element, which only happens if
+ *  the matrix has not been ordered.  The schedule is then discarded.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (MatrixPtr)
+ *      Pointer to matrix.
+ */
+
+static BOOLEAN CompileFactor(MatrixPtr Matrix)
+{
+    ElementPtr pElement, pColumn;
+    int Step, Size;
+    struct CompiledFactor* pCompiled;
+    std::vector<RealNumber*> Dest;
+
+    /* Begin `CompileFactor'. */
+    delete Matrix->Compiled;
+    Matrix->Compiled = NULL;
+    if (NOT Matrix->RowsLinked)
+        spcLinkRows(Matrix);
+
+    Size = Matrix->Size;
+    pCompiled = new CompiledFactor;
+    pCompiled->Elements = Matrix->Elements;
+    pCompiled->Diag.resize(Size + 1);
+    pCompiled->StepEnd.assign(Size + 1, 1);
+    pCompiled->UpperEnd.push_back(1);
+    pCompiled->Upper.push_back(NULL);
+    pCompiled->UpperPivot.push_back(NULL);
+    pCompiled->UpdateDest.push_back(NULL);
+    pCompiled->UpdateSrc.push_back(NULL);
+    Dest.assign(Size + 1, NULL);
+
+    for (Step = 1; Step <= Size; Step++) {
+        pCompiled->Diag[Step] = &Matrix->Diag[Step]->Real;
+
+        /* Scatter. */
+        for (pElement = Matrix->FirstInCol[Step]; pElement != NULL; pElement = pElement->NextInCol)
+            Dest[pElement->Row] = &pElement->Real;
+
+        /* Record the column update. */
+        pColumn = Matrix->FirstInCol[Step];
+        while (pColumn->Row < Step) {
+            pElement = Matrix->Diag[pColumn->Row];
+            pCompiled->Upper.push_back(&pColumn->Real);
+            pCompiled->UpperPivot.push_back(&pElement->Real);
+            while ((pElement = pElement->NextInCol) != NULL) {
+                if (Dest[pElement->Row] == NULL) {
+                    delete pCompiled;
+                    return NO;
+                }
+                pCompiled->UpdateDest.push_back(Dest[pElement->Row]);
+                pCompiled->UpdateSrc.push_back(&pElement->Real);
+            }
+            pCompiled->UpperEnd.push_back((int)pCompiled->UpdateDest.size());
+            pColumn = pColumn->NextInCol;
+        }
+        pCompiled->StepEnd[Step] = (int)pCompiled->Upper.size();
+
+        /* Clear the scatter so that missing elements are detected. */
+        for (pElement = Matrix->FirstInCol[Step]; pElement != NULL; pElement = pElement->NextInCol)
+            Dest[pElement->Row] = NULL;
+    }
+
+    /* Lower triangle by column and upper triangle by row, for spSolveCompiled(). */
+    pCompiled->LowerEnd.assign(Size + 1, 0);
+    pCompiled->RowEnd.assign(Size + 1, 0);
+    for (Step = 1; Step <= Size; Step++) {
+        for (pElement = Matrix->Diag[Step]->NextInCol; pElement != NULL; pElement = pElement->NextInCol) {
+            pCompiled->LowerRow.push_back(pElement->Row);
+            pCompiled->LowerVal.push_back(&pElement->Real);
+        }
+        pCompiled->LowerEnd[Step] = (int)pCompiled->LowerRow.size();
+        for (pElement = Matrix->Diag[Step]->NextInRow; pElement != NULL; pElement = pElement->NextInRow) {
+            pCompiled->RowCol.push_back(pElement->Col);
+            pCompiled->RowVal.push_back(&pElement->Real);
+        }
+        pCompiled->RowEnd[Step] = (int)pCompiled->RowCol.size();
+    }
+
+    Matrix->Compiled = pCompiled;
+    return YES;
+}
+
 /*
  *  PARTITION MATRIX
  *
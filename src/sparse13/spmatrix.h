@@ -235,6 +235,7 @@ extern void spDestroy(char*);
 extern int spElementCount(char*);
 extern int spError(char*);
 extern int spFactor(char*);
+extern int spFactorCompiled(char*);
 extern int spFileMatrix(char*, char*, char*, int, int, int);
 extern int spFileStats(char*, char*, char*);
 extern int spFillinCount(char*);
@@ -265,6 +266,7 @@ extern int spFileVector(char*, char*, spREAL*, std::optional<spREAL*> = std::nul
 extern void spMultiply(char*, spREAL*, spREAL*, std::optional<spREAL*> = std::nullopt, std::optional<spREAL*> = std::nullopt);
 extern void spMultTransposed(char* eMatrix, spREAL* RHS, spREAL* Solution, std::optional<spREAL*> iRHS = std::nullopt, std::optional<spREAL*> iSolution = std::nullopt);
 extern void spSolve(char* eMatrix, spREAL* RHS, spREAL* Solution, std::optional<spREAL*> iRHS = std::nullopt, std::optional<spREAL*> iSolution = std::nullopt);
+extern void spSolveCompiled(char*, spREAL*, spREAL*);
 extern void spSolveTransposed(char*, spREAL*, spREAL*, std::optional<spREAL*> = std::nullopt, std::optional<spREAL*> = std::nullopt);
 
 #endif /* spOKAY */
@@ -164,6 +164,90 @@ void spSolve(char* eMatrix, RealVector RHS, RealVector Solution, std::optional<R
 #endif /* REAL */
 }
 
+/*
+ *  SOLVE MATRIX EQUATION USING A COMPILED SCHEDULE
+ *
+ *  Same as spSolve() for a real matrix factored by spFactorCompiled(),
+ *  but the factors are read through the flat arrays of the compiled
+ *  schedule instead of the linked lists.  The operations, and their
+ *  order, are the same as those of spSolve(), so the solution is the
+ *  same.  If there is no schedule, spSolve() is used.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (char *)
+ *      Pointer to matrix.
+ *  RHS  <input>  (RealVector)
+ *      RHS is the input data array, the right hand side.
+ *  Solution  <output>  (RealVector)
+ *      Solution is the output data array.  RHS and Solution can be the
+ *      same array.
+ */
+
+void spSolveCompiled(char* eMatrix, RealVector RHS, RealVector Solution)
+{
+    MatrixPtr Matrix = (MatrixPtr)eMatrix;
+    struct CompiledFactor* pCompiled;
+    RealVector Intermediate;
+    RealNumber Temp;
+    RealNumber *const* Diag;
+    RealNumber *const* LowerVal;
+    RealNumber *const* RowVal;
+    const int *LowerEnd, *LowerRow, *RowEnd, *RowCol;
+    int I, J, *pExtOrder, Size;
+
+    /* Begin `spSolveCompiled'. */
+    ASSERT(IS_VALID(Matrix) AND IS_FACTORED(Matrix));
+    pCompiled = Matrix->Compiled;
+    if (pCompiled == NULL OR Matrix->NeedsOrdering) {
+        spSolve(eMatrix, RHS, Solution);
+        return;
+    }
+
+    Intermediate = Matrix->Intermediate;
+    Size = Matrix->Size;
+    Diag = pCompiled->Diag.data();
+    LowerEnd = pCompiled->LowerEnd.data();
+    LowerRow = pCompiled->LowerRow.data();
+    LowerVal = pCompiled->LowerVal.data();
+    RowEnd = pCompiled->RowEnd.data();
+    RowCol = pCompiled->RowCol.data();
+    RowVal = pCompiled->RowVal.data();
+
+/* Correct array pointers for ARRAY_OFFSET. */
+#if NOT ARRAY_OFFSET
+    --RHS;
+    --Solution;
+#endif
+
+    /* Initialize Intermediate vector. */
+    pExtOrder = &Matrix->IntToExtRowMap[Size];
+    for (I = Size; I > 0; I--)
+        Intermediate[I] = RHS[*(pExtOrder--)];
+
+    /* Forward elimination. Solves Lc = b.*/
+    for (I = 1; I <= Size; I++) {
+        /* This step of the elimination is skipped if Temp equals zero. */
+        if ((Temp = Intermediate[I]) != 0.0) {
+            Intermediate[I] = (Temp *= *Diag[I]);
+            for (J = LowerEnd[I - 1]; J < LowerEnd[I]; J++)
+                Intermediate[LowerRow[J]] -= Temp * *LowerVal[J];
+        }
+    }
+
+    /* Backward Substitution. Solves Ux = c.*/
+    for (I = Size; I > 0; I--) {
+        Temp = Intermediate[I];
+        for (J = RowEnd[I - 1]; J < RowEnd[I]; J++)
+            Temp -= *RowVal[J] * Intermediate[RowCol[J]];
+        Intermediate[I] = Temp;
+    }
+
+    /* Unscramble Intermediate vector while placing data in to Solution vector. */
+    pExtOrder = &Matrix->IntToExtColMap[Size];
+    for (I = Size; I > 0; I--)
+        Solution[*(pExtOrder--)] = Intermediate[I];
+}
+
 #if TRANSPOSE
 /*
  *  SOLVE TRANSPOSED MATRIX EQUATION
@@ -636,6 +636,8 @@ void spStripFills(char* eMatrix)
     if (Matrix->Fillins == 0)
         return;
     Matrix->NeedsOrdering = YES;
+    delete Matrix->Compiled;
+    Matrix->Compiled = NULL;
     Matrix->Elements -= Matrix->Fillins;
     Matrix->Fillins = 0;
 
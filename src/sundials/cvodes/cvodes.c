@@ -3577,14 +3577,12 @@ static void CVRescale(CVodeMem cv_mem)
   int j;
   int is;
   realtype factor;
+  realtype c[L_MAX];
 
   factor = eta;
   for (j=1; j <= q; j++) {
 
-    N_VScale(factor, zn[j], zn[j]);
-
-    if (quadr)
-      N_VScale(factor, znQ[j], znQ[j]);
+    c[j-1] = factor;
 
     if (sensi)
       for (is=0; is<Ns; is++)
@@ -3593,6 +3591,12 @@ static void CVRescale(CVodeMem cv_mem)
     factor *= eta;
 
   }
+
+  /* zn[j] *= eta^j, fused over j */
+  N_VScaleVectorArray(q, c, zn+1, zn+1);
+
+  if (quadr)
+    N_VScaleVectorArray(q, c, znQ+1, znQ+1);
   h = hscale * eta;
   hscale = h;
   nscon = 0;
@@ -5227,13 +5231,10 @@ static void CVCompleteStep(CVodeMem cv_mem)
 
   /* Apply correction to column j of zn: l_j * Delta_n */
 
-  for (j=0; j <= q; j++) 
-    N_VLinearSum(l[j], acor, ONE, zn[j], zn[j]);
+  N_VScaleAddMulti(q+1, l, acor, zn, zn);
 
-  if (quadr) {
-    for (j=0; j <= q; j++) 
-      N_VLinearSum(l[j], acorQ, ONE, znQ[j], znQ[j]);
-  }
+  if (quadr)
+    N_VScaleAddMulti(q+1, l, acorQ, znQ, znQ);
 
   if (sensi) {
     for (is=0; is<Ns; is++)
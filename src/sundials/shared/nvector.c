@@ -170,6 +170,34 @@ realtype N_VMinQuotient(N_Vector num, N_Vector denom)
   return(quotient);
 }
 
+/*
+ * -----------------------------------------------------------------
+ * Fused operations
+ * -----------------------------------------------------------------
+ */
+
+void N_VScaleVectorArray(int nvec, realtype *c, N_Vector *X, N_Vector *Z)
+{
+  int i;
+  if (nvec < 1) return;
+  if (X[0]->ops->nvscalevectorarray) {
+    X[0]->ops->nvscalevectorarray(nvec, c, X, Z);
+    return;
+  }
+  for (i = 0; i < nvec; i++) N_VScale(c[i], X[i], Z[i]);
+}
+
+void N_VScaleAddMulti(int nvec, realtype *a, N_Vector x, N_Vector *Y, N_Vector *Z)
+{
+  int i;
+  if (nvec < 1) return;
+  if (x->ops->nvscaleaddmulti) {
+    x->ops->nvscaleaddmulti(nvec, a, x, Y, Z);
+    return;
+  }
+  for (i = 0; i < nvec; i++) N_VLinearSum(a[i], x, RCONST(1.0), Y[i], Z[i]);
+}
+
 /*
  * -----------------------------------------------------------------
  * Additional functions exported by the generic NVECTOR:
@@ -90,6 +90,9 @@ struct _generic_N_Vector_Ops {
   booleantype (*nvinvtest)(N_Vector, N_Vector);
   booleantype (*nvconstrmask)(N_Vector, N_Vector, N_Vector);
   realtype    (*nvminquotient)(N_Vector, N_Vector);
+  /* fused operations, optional (NULL) */
+  void        (*nvscalevectorarray)(int, realtype *, N_Vector *, N_Vector *);
+  void        (*nvscaleaddmulti)(int, realtype *, N_Vector, N_Vector *, N_Vector *);
 };
   
 /*
@@ -330,6 +333,26 @@ booleantype N_VInvTest(N_Vector x, N_Vector z);
 booleantype N_VConstrMask(N_Vector c, N_Vector x, N_Vector m);
 realtype N_VMinQuotient(N_Vector num, N_Vector denom);
 
+/*
+ * -----------------------------------------------------------------
+ * Fused operations
+ * -----------------------------------------------------------------
+ * N_VScaleVectorArray
+ *   Z[i] = c[i] * X[i] for i = 0, ..., nvec-1
+ *
+ * N_VScaleAddMulti
+ *   Z[i] = a[i] * x + Y[i] for i = 0, ..., nvec-1
+ *
+ * An implementation whose operations each cost a synchronization,
+ * e.g. one per thread, can do all nvec in one pass. When the op is
+ * NULL they are done by nvec calls of N_VScale and N_VLinearSum,
+ * with the same result.
+ * -----------------------------------------------------------------
+ */
+
+void N_VScaleVectorArray(int nvec, realtype *c, N_Vector *X, N_Vector *Z);
+void N_VScaleAddMulti(int nvec, realtype *a, N_Vector x, N_Vector *Y, N_Vector *Z);
+
 /*
  * -----------------------------------------------------------------
  * Additional functions exported by nvector
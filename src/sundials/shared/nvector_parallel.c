@@ -123,6 +123,8 @@ N_Vector N_VNewEmpty_Parallel(MPI_Comm comm,
   ops->nvinvtest         = N_VInvTest_Parallel;
   ops->nvconstrmask      = N_VConstrMask_Parallel;
   ops->nvminquotient     = N_VMinQuotient_Parallel;
+  ops->nvscalevectorarray = NULL;
+  ops->nvscaleaddmulti    = NULL;
 
   /* Create content */
   content = (N_VectorContent_Parallel) malloc(sizeof(struct _N_VectorContent_Parallel));
@@ -216,6 +218,8 @@ N_Vector N_VCloneEmpty_Parallel(N_Vector w)
   ops->nvinvtest         = w->ops->nvinvtest;
   ops->nvconstrmask      = w->ops->nvconstrmask;
   ops->nvminquotient     = w->ops->nvminquotient;
+  ops->nvscalevectorarray = w->ops->nvscalevectorarray;
+  ops->nvscaleaddmulti    = w->ops->nvscaleaddmulti;
 
   /* Create content */  
   content = (N_VectorContent_Parallel) malloc(sizeof(struct _N_VectorContent_Parallel));
@@ -107,6 +107,8 @@ N_Vector N_VNewEmpty_Serial(long int length)
   ops->nvinvtest         = N_VInvTest_Serial;
   ops->nvconstrmask      = N_VConstrMask_Serial;
   ops->nvminquotient     = N_VMinQuotient_Serial;
+  ops->nvscalevectorarray = NULL;
+  ops->nvscaleaddmulti    = NULL;
 
   /* Create content */
   content = (N_VectorContent_Serial) malloc(sizeof(struct _N_VectorContent_Serial));
@@ -201,6 +203,8 @@ N_Vector N_VCloneEmpty_Serial(N_Vector w)
   ops->nvinvtest         = w->ops->nvinvtest;
   ops->nvconstrmask      = w->ops->nvconstrmask;
   ops->nvminquotient     = w->ops->nvminquotient;
+  ops->nvscalevectorarray = w->ops->nvscalevectorarray;
+  ops->nvscaleaddmulti    = w->ops->nvscaleaddmulti;
 
   /* Create content */
   content = (N_VectorContent_Serial) malloc(sizeof(struct _N_VectorContent_Serial));
@@ -0,0 +1,82 @@
+#include "code.h"
+#include "hocdec.h"
+#include "ocfunc.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+/* @brief
+ *  Benchmark the parallel binary BBSaveState checkpoint: save_bin (serialize
+ *  to memory, then write the file in the background), save_wait, and
+ *  restore_bin, reported as throughput in GB/s of checkpoint data.
+ *      * NOTE: GitHub runners don't have enough capabilities for performance KPIs
+ */
+
+namespace {
+constexpr auto bbss_cell_template = R"(
+begintemplate BBSSCell
+public soma, dend, spkout
+create soma, dend[4]
+objref spkout, syn
+proc init() { local i
+    for i = 0, 3 {
+        connect dend[i](0), soma(1)
+        dend[i] { L = 300  diam = 1  nseg = 51  insert hh }
+    }
+    soma { L = diam = 20  insert hh  spkout = new NetCon(&v(.5), nil) }
+    dend[0] syn = new ExpSyn(.5)
+}
+endtemplate BBSSCell
+
+objref bbss_pc, bbss_cells, bbss, nil
+bbss_pc = new ParallelContext()
+bbss_cells = new List()
+proc bbss_mkcells() { local i
+    for i = 0, $1 - 1 {
+        bbss_cells.append(new BBSSCell())
+        bbss_pc.set_gid2node(1000000 + i, bbss_pc.id)
+        bbss_pc.cell(1000000 + i, bbss_cells.o(i).spkout)
+    }
+}
+)";
+
+double seconds_since(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start)
+        .count();
+}
+}  // namespace
+
+TEST_CASE("Parallel binary BBSaveState throughput", "[NEURON][bbsavestate][benchmark]") {
+    REQUIRE(hoc_oc(bbss_cell_template) == 0);
+    REQUIRE(hoc_oc("bbss_mkcells(2000)\n"
+                   "finitialize(-65)\n"
+                   "bbss = new BBSaveState()\n") == 0);
+    const char* dir = "bbss_bench";
+
+    auto start = std::chrono::high_resolution_clock::now();
+    REQUIRE(hoc_oc("hoc_ac_ = bbss.save_bin(\"bbss_bench\")\n") == 0);
+    double const t_snapshot = seconds_since(start);
+    double const nbyte = hoc_ac_;
+    REQUIRE(hoc_oc("bbss.save_wait()\n") == 0);
+    double const t_save = seconds_since(start);
+    REQUIRE(std::filesystem::file_size(std::string(dir) + "/bbss.0") == std::size_t(nbyte));
+
+    start = std::chrono::high_resolution_clock::now();
+    REQUIRE(hoc_oc("finitialize(-65)\n"
+                   "hoc_ac_ = bbss.restore_bin(\"bbss_bench\")\n") == 0);
+    double const t_restore = seconds_since(start);
+    REQUIRE(hoc_ac_ == 2000);
+
+    auto const gbs = [nbyte](double t) { return nbyte / t * 1e-9; };
+    std::cout << "BBSaveState binary checkpoint of " << nbyte * 1e-6 << " MB: snapshot "
+              << gbs(t_snapshot) << " GB/s, save " << gbs(t_save) << " GB/s, restore "
+              << gbs(t_restore) << " GB/s" << std::endl;
+
+    REQUIRE(hoc_oc("bbss = nil\n"
+                   "bbss_pc.gid_clear()\n"
+                   "bbss_cells.remove_all()\n") == 0);
+    std::filesystem::remove_all(dir);
+}
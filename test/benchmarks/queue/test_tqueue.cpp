@@ -0,0 +1,67 @@
+#include "tqueue.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/* @brief
+ *  Benchmark the TQueue event set with the splay tree and the calendar queue.
+ *  Classic hold model: n pending events, each delivery schedules one new
+ *  event after a synaptic delay. Delays are log-normal (median about 3 ms),
+ *  either as is or rounded to multiples of dt, in which case many events
+ *  share a delivery time.
+ *      * NOTE: GitHub runners don't have enough capabilities for performance KPIs
+ */
+
+namespace {
+double hold(bool calendar, bool quantized, std::size_t n, std::size_t ndeliver) {
+    nrn_use_calendar_queue_ = calendar;
+    TQItemPool pool(n);
+    TQueue tq(&pool);
+    nrn_use_calendar_queue_ = false;
+    std::mt19937 gen(1);
+    std::lognormal_distribution<double> delay(1.1, 0.6);
+    constexpr double dt = 0.025;
+    auto next = [&](double t) {
+        double d = delay(gen);
+        return t + (quantized ? dt * std::max(1.0, std::round(d / dt)) : d);
+    };
+    for (std::size_t i = 0; i < n; ++i) {
+        tq.insert(next(0.0), reinterpret_cast<void*>(std::intptr_t(i)));
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    double t = 0.0;
+    std::size_t ndelivered = 0;
+    while (ndelivered < ndeliver) {
+        t += dt;
+        while (TQItem* q = tq.atomic_dq(t)) {
+            tq.insert(next(t), q->data_);
+            tq.release(q);
+            ++ndelivered;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+}  // namespace
+
+TEST_CASE("Event queue benchmark", "[NEURON][tqueue]") {
+    std::cout << "[tqueue][hold model, 2e6 deliveries] : " << std::endl;
+    std::cout << "delays\tpending\tsplay (us)\tcalendar (us)" << std::endl;
+    for (bool quantized: {false, true}) {
+        for (std::size_t n: {1'000, 100'000, 1'000'000}) {
+            double splay = hold(false, quantized, n, 2'000'000);
+            double calendar = hold(true, quantized, n, 2'000'000);
+            std::cout << (quantized ? "k*dt" : "any") << "\t" << n << "\t" << splay << "\t"
+                      << calendar << std::endl;
+            REQUIRE(splay > 0);
+            REQUIRE(calendar > 0);
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#include "rxd_tridiag.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+/* @brief
+ *  Benchmark the tridiagonal solves of a homogeneous DG-ADI step on a 200^3
+ *  grid along y, where consecutive lines are adjacent in memory and the
+ *  elements of a line are size_z apart. Lines are either solved one at a time,
+ *  gathered into a contiguous buffer, or ECS_ADI_LANES at a time with the
+ *  matrix factored once.
+ *      * NOTE: GitHub runners don't have enough capabilities for performance KPIs
+ */
+
+namespace {
+constexpr int size = 200;
+constexpr double r = 0.3;
+
+/* same arithmetic as solve_dd_clhs_tridiag in rxd_extracellular.cpp */
+void solve_line(int N, double* b, double* c) {
+    c[0] = (-r / 2.0) / (1.0 + r / 2.0);
+    b[0] = b[0] / (1.0 + r / 2.0);
+    for (int i = 1; i < N - 1; i++) {
+        c[i] = (-r / 2.0) / ((1.0 + r) - (-r / 2.0) * c[i - 1]);
+        b[i] = (b[i] - (-r / 2.0) * b[i - 1]) / ((1.0 + r) - (-r / 2.0) * c[i - 1]);
+    }
+    b[N - 1] = (b[N - 1] - (-r / 2.0) * b[N - 2]) / ((1.0 + r / 2.0) - (-r / 2.0) * c[N - 2]);
+    for (int i = N - 2; i >= 0; i--) {
+        b[i] = b[i] - c[i] * b[i + 1];
+    }
+}
+
+void fill(std::vector<double>& state) {
+    for (std::size_t i = 0; i < state.size(); ++i) {
+        state[i] = double((i * 7919) % 1009) / 1009.0;
+    }
+}
+
+double line_at_a_time(std::vector<double>& state) {
+    std::vector<double> b(size), c(size);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int x = 0; x < size; ++x) {
+        for (int z = 0; z < size; ++z) {
+            double* line = &state[z + x * size * size];
+            for (int y = 0; y < size; ++y) {
+                b[y] = line[y * size];
+            }
+            solve_line(size, b.data(), c.data());
+            for (int y = 0; y < size; ++y) {
+                line[y * size] = b[y];
+            }
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+double lanes(std::vector<double>& state) {
+    std::vector<double> c(size), den(size), tile(ECS_ADI_LANES * size);
+    auto start = std::chrono::high_resolution_clock::now();
+    factor_dd_clhs_tridiag(size,
+                           -r / 2.0,
+                           1.0 + r,
+                           -r / 2.0,
+                           1.0 + r / 2.0,
+                           -r / 2.0,
+                           -r / 2.0,
+                           1.0 + r / 2.0,
+                           c.data(),
+                           den.data());
+    for (int x = 0; x < size; ++x) {
+        for (int z = 0; z < size; z += ECS_ADI_LANES) {
+            const int nlane = std::min(ECS_ADI_LANES, size - z);
+            double* line = &state[z + x * size * size];
+            for (int y = 0; y < size; ++y) {
+                for (int l = 0; l < nlane; ++l) {
+                    tile[y * nlane + l] = line[y * size + l];
+                }
+            }
+            solve_dd_clhs_tridiag_lanes(
+                size, nlane, -r / 2.0, -r / 2.0, c.data(), den.data(), tile.data());
+            for (int y = 0; y < size; ++y) {
+                for (int l = 0; l < nlane; ++l) {
+                    line[y * size + l] = tile[y * nlane + l];
+                }
+            }
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+}  // namespace
+
+TEST_CASE("rxd ADI tridiagonal benchmark", "[NEURON][rxd]") {
+    std::vector<double> a(std::size_t(size) * size * size), b(a.size());
+    fill(a);
+    fill(b);
+    double single = line_at_a_time(a);
+    double batched = lanes(b);
+    std::cout << "[rxd][200^3 y sweep] line at a time (us)\t" << ECS_ADI_LANES
+              << " lanes (us)" << std::endl;
+    std::cout << single << "\t" << batched << std::endl;
+    REQUIRE(a == b);
+}
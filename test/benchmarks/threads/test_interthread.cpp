@@ -0,0 +1,101 @@
+#include "test_multicore.h"
+
+#include "hocdec.h"
+#include "multicore.h"
+#include "oc_ansi.h"
+#include "ocfunc.h"
+
+#include <catch2/generators/catch_generators_range.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+/* @brief
+ *  Benchmark cross-thread NetCon event delivery.
+ *  Every cell connects to every other cell with distinct delays so that each
+ *  spike results in one NetCvodeThreadData::interthread_send per NetCon whose
+ *  target lives on another thread.
+ *      * NOTE: GitHub runners don't have enough capabilities for performance KPIs
+ */
+
+constexpr auto interthread_net = R"(
+begintemplate SpikeCell
+public soma, syn, connect2target
+create soma
+objref syn, icl
+proc init() {
+  soma {
+    L = 20  diam = 20
+    insert hh
+    syn = new ExpSyn(0.5)
+    icl = new IClamp(0.5)
+  }
+  icl.del = 0  icl.dur = 1e9  icl.amp = $1
+}
+obfunc connect2target() { localobj nc
+  soma nc = new NetCon(&v(0.5), $o1)
+  nc.threshold = 0
+  return nc
+}
+endtemplate SpikeCell
+
+objref ipc, icells, incs, ispikes, igids
+ipc = new ParallelContext()
+icells = new List()
+incs = new List()
+proc interthread_net() { local i, j
+  for i = 0, $1 - 1 {
+    icells.append(new SpikeCell(0.2 + 0.1 * i / $1))
+  }
+  for i = 0, $1 - 1 for j = 0, $1 - 1 if (i != j) {
+    incs.append(icells.o(i).connect2target(icells.o(j).syn))
+    incs.o(incs.count - 1).delay = 1 + ((i + j) % 8) * 0.125
+    incs.o(incs.count - 1).weight = 0
+  }
+  ispikes = new Vector()
+  igids = new Vector()
+  for i = 0, $1 - 1 {
+    incs.o(i * ($1 - 1)).record(ispikes, igids, i)
+  }
+}
+func interthread_run() {
+  ipc.set_maxstep(10)
+  finitialize(-65)
+  ipc.psolve($1)
+  return ispikes.size
+}
+)";
+
+TEST_CASE("Interthread event delivery benchmark", "[NEURON][multicore][interthread]") {
+    static const auto nof_threads_range{nrn::test::make_available_threads_range()};
+    REQUIRE(hoc_oc(interthread_net) == 0);
+    REQUIRE(hoc_oc("interthread_net(128)") == 0);
+    std::vector<double> sim_times;
+    std::vector<double> nspikes;
+    for (auto nof_threads: nof_threads_range) {
+        nrn_threads_create(nof_threads, 1);
+        REQUIRE(nrn_nthread == nof_threads);
+        auto start = std::chrono::high_resolution_clock::now();
+        REQUIRE(hoc_oc("hoc_ac_ = interthread_run(200)") == 0);
+        auto end = std::chrono::high_resolution_clock::now();
+        sim_times.push_back(
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+        nspikes.push_back(hoc_ac_);
+    }
+    // weights are 0, so the spike trains must not depend on the number of threads
+    REQUIRE(nspikes.front() > 0);
+    for (auto n: nspikes) {
+        REQUIRE(n == nspikes.front());
+    }
+    std::cout << "[interthread][simulation times] : " << std::endl;
+    std::cout << "nt"
+              << "\t"
+              << "time (us)" << std::endl;
+    for (auto i = 0; i < sim_times.size(); ++i) {
+        std::cout << nof_threads_range[i] << "\t" << sim_times[i] << std::endl;
+    }
+    REQUIRE(hoc_oc("incs.remove_all() icells.remove_all()") == 0);
+    nrn_threads_create(1, 0);
+}
@@ -121,7 +121,7 @@ func prun() {local runtime
 
 
 // utility to create a given number of passive membrane cells (nof_cells)
-std::string operator"" _pas_cells(unsigned long long nof_cells) {
+inline std::string operator"" _pas_cells(unsigned long long nof_cells) {
     std::string cells = "ncell = " + std::to_string(nof_cells);
     cells += R"(
     objref cell[ncell]
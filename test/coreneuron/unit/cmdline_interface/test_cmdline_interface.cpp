@@ -55,6 +55,8 @@ TEST_CASE("cmdline_interface") {
 
         "--binqueue",
 
+        "--mmap",
+
         "--spikebuf",
         "100",
 
@@ -119,6 +121,8 @@ TEST_CASE("cmdline_interface") {
 
     REQUIRE(corenrn_param_test.spkcompress == 32);
 
+    REQUIRE(corenrn_param_test.mmap_input == true);
+
     REQUIRE(corenrn_param_test.multisend == true);
 
     // Reset all parameters to their default values.
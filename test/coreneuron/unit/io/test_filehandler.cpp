@@ -0,0 +1,126 @@
+/*
+# =============================================================================
+# Copyright (c) 2016 - 2022 Blue Brain Project/EPFL
+#
+# See top-level LICENSE file for details.
+# =============================================================================.
+*/
+#include "coreneuron/apps/corenrn_parameters.hpp"
+#include "coreneuron/io/nrn_filehandler.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace coreneuron;
+
+namespace {
+// Resident set size in kB
+long current_rss() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmRSS:", 0) == 0) {
+            return std::stol(line.substr(6));
+        }
+    }
+    return 0;
+}
+
+// Same layout as a phase2 file: version line, integer lines and
+// checkpointed binary arrays.
+void write_phase_file(const std::string& fname, std::size_t n) {
+    std::vector<int> parent(n);
+    std::iota(parent.begin(), parent.end(), -1);
+    std::vector<double> area(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        area[i] = 0.5 * i;
+    }
+    FileHandler F;
+    F.open(fname, std::ios::out);
+    F << int(n) << "\n";
+    F.write_array(parent.data(), n);
+    F.write_array(area.data(), n);
+    F << 42 << "\n";
+    F.write_array(area.data(), n);
+    F.close();
+}
+
+// Returns the time to load the file in seconds.
+double read_phase_file(const std::string& fname, bool mmap, long& rss_increase) {
+    corenrn_param.mmap_input = mmap;
+    long rss = current_rss();
+    auto start = std::chrono::steady_clock::now();
+    FileHandler F;
+    F.open(fname);
+    REQUIRE(!F.fail());
+    REQUIRE(F.mapped() == mmap);
+    F.checkpoint(0);
+    std::size_t n = F.read_int();
+    auto parent = F.read_vector<int>(n);
+    std::vector<double> area(n);
+    F.read_array(area.data(), n);
+    REQUIRE(F.read_int() == 42);
+    F.parse_array<double>(nullptr, n, FileHandler::seek);
+    REQUIRE(F.eof());
+    rss_increase = current_rss() - rss;
+    F.close();
+    auto end = std::chrono::steady_clock::now();
+    corenrn_param.mmap_input = false;
+    for (std::size_t i = 0; i < n; i += 997) {
+        REQUIRE(parent[i] == int(i) - 1);
+        REQUIRE(area[i] == 0.5 * i);
+    }
+    return std::chrono::duration<double>(end - start).count();
+}
+}  // namespace
+
+TEST_CASE("FileHandler stream and mmap reads agree", "[coreneuron][io]") {
+    const std::string fname{"filehandler_test_phase.dat"};
+    write_phase_file(fname, 1000);
+    long rss;
+    read_phase_file(fname, false, rss);
+    read_phase_file(fname, true, rss);
+    std::remove(fname.c_str());
+}
+
+TEST_CASE("FileHandler last line without newline", "[coreneuron][io]") {
+    const std::string fname{"filehandler_test_nonewline.dat"};
+    {
+        std::ofstream f(fname);
+        f << "12\n34";
+    }
+    for (bool mmap: {false, true}) {
+        corenrn_param.mmap_input = mmap;
+        FileHandler F;
+        F.open(fname);
+        REQUIRE(F.mapped() == mmap);
+        REQUIRE(F.read_int() == 12);
+        REQUIRE(F.read_int() == 34);
+        REQUIRE(F.eof());
+        F.close();
+    }
+    corenrn_param.mmap_input = false;
+    std::remove(fname.c_str());
+}
+
+TEST_CASE("FileHandler load benchmark", "[coreneuron][io][.benchmark]") {
+    // 10M node arrays, about 200 MB on disk
+    const std::string fname{"filehandler_bench_phase.dat"};
+    constexpr std::size_t n = 10'000'000;
+    write_phase_file(fname, n);
+    long rss_stream, rss_mmap;
+    double t_stream = read_phase_file(fname, false, rss_stream);
+    double t_mmap = read_phase_file(fname, true, rss_mmap);
+    std::remove(fname.c_str());
+    std::cout << "[filehandler] " << n << " nodes" << std::endl
+              << "mode\ttime (s)\tRSS increase (kB)" << std::endl
+              << "stream\t" << t_stream << "\t" << rss_stream << std::endl
+              << "mmap\t" << t_mmap << "\t" << rss_mmap << std::endl;
+}
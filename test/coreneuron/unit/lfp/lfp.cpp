@@ -113,6 +113,52 @@ TEST_CASE("LFP_PointSource_LineSource") {
 #endif
 }
 
+TEST_CASE("LFP_Blocked") {
+    // more electrodes than a tile and a ragged last tile
+    const size_t nseg = 2000;
+    const size_t nelec = 37;
+    std::vector<std::array<double, 3>> starts(nseg), ends(nseg), electrodes(nelec);
+    std::vector<double> radii(nseg, 0.5);
+    std::vector<int> indices(nseg);
+    std::vector<double> currents(nseg + 10);
+    for (size_t l = 0; l < nseg; ++l) {
+        starts[l] = {double(l % 40), double(l / 40), 0.0};
+        ends[l] = {double(l % 40) + 0.8, double(l / 40), 0.3};
+        indices[l] = int(nseg - 1 - l) + 10;
+    }
+    for (size_t i = 0; i < currents.size(); ++i) {
+        currents[i] = std::sin(0.1 * i);
+    }
+    for (size_t k = 0; k < nelec; ++k) {
+        electrodes[k] = {3.0 * k, 10.0 - 0.5 * k, 5.0 + k % 3};
+    }
+    // the unblocked sum over the segments
+    double f = 1.0 / (0.3 * 4.0 * pi);
+    std::vector<double> expected(nelec);
+    for (size_t k = 0; k < nelec; ++k) {
+        for (size_t l = 0; l < nseg; ++l) {
+            expected[k] += line_source_lfp_factor(electrodes[k], starts[l], ends[l], radii[l], f) *
+                           currents[indices[l]];
+        }
+    }
+
+    LFPCalculator<LineSource> lfp(starts, ends, radii, indices, electrodes, 0.3);
+    LFPCalculator<LineSource, int, float> lfpf(starts, ends, radii, indices, electrodes, 0.3);
+    lfp.lfp(currents);
+    lfpf.lfp(currents);
+    REQUIRE(lfp.lfp_values().size() == nelec);
+    for (size_t k = 0; k < nelec; ++k) {
+        REQUIRE_THAT(lfp.lfp_values()[k], Catch::Matchers::WithinRel(expected[k], 1e-12));
+        REQUIRE_THAT(lfpf.lfp_values()[k], Catch::Matchers::WithinRel(expected[k], 1e-5));
+    }
+
+    // the split form gives the same values
+    std::vector<double> values = lfp.lfp_values();
+    lfp.lfp_start(currents);
+    lfp.lfp_wait();
+    REQUIRE(lfp.lfp_values() == values);
+}
+
 #ifdef ENABLE_SONATA_REPORTS
 #define CATCH_CONFIG_MAIN
 
@@ -0,0 +1,87 @@
+/*
+# =============================================================================
+# Copyright (c) 2016 - 2024 Blue Brain Project/EPFL
+#
+# See top-level LICENSE file for details.
+# =============================================================================.
+*/
+#include "coreneuron/io/reports/nrnreport.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace coreneuron;
+
+namespace {
+// the ReportType enumerator hides the struct name
+using Summation = struct SummationReport;
+
+constexpr size_t nthread = 8;
+constexpr size_t nnode = 5000;
+
+// Currents of a thread and their registration as report_handler does it, a
+// few mechanisms per segment and the clamps with a scale of -1
+struct ThreadReport {
+    std::vector<double> currents;
+    Summation report;
+
+    explicit ThreadReport(unsigned seed)
+        : currents(4 * nnode) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> value(-1.0, 1.0);
+        for (auto& current: currents) {
+            current = value(gen);
+        }
+        for (size_t segment_id = 0; segment_id < nnode; ++segment_id) {
+            for (size_t k = 0; k < 1 + segment_id % 4; ++k) {
+                int scale = (k == 3) ? -1 : 1;
+                report.currents_[segment_id].emplace_back(&currents[4 * segment_id + k], scale);
+            }
+        }
+        report.build_csr(nnode);
+    }
+};
+
+// summation as done before the currents were flattened
+void sum_map(Summation& report) {
+    for (const auto& kv: report.currents_) {
+        double sum = 0.0;
+        for (const auto& value: kv.second) {
+            sum += *value.first * value.second;
+        }
+        report.summation_[kv.first] = sum;
+    }
+}
+}  // namespace
+
+TEST_CASE("summation_report_csr") {
+    std::vector<ThreadReport> threads;
+    threads.reserve(nthread);
+    for (size_t i = 0; i < nthread; ++i) {
+        threads.emplace_back(i + 1);
+    }
+    for (auto& thread: threads) {
+        REQUIRE(thread.report.segments_.size() == nnode);
+        REQUIRE(thread.report.offsets_.back() == thread.report.current_ptrs_.size());
+    }
+
+    // reference sums walking the map, as ReportEvent::deliver used to
+    std::vector<std::vector<double>> expected;
+    for (auto& thread: threads) {
+        sum_map(thread.report);
+        expected.push_back(thread.report.summation_);
+        std::fill(thread.report.summation_.begin(), thread.report.summation_.end(), 0.0);
+    }
+
+    // each thread sums its own flattened currents concurrently
+#pragma omp parallel for
+    for (size_t i = 0; i < nthread; ++i) {
+        threads[i].report.sum_currents();
+    }
+
+    for (size_t i = 0; i < nthread; ++i) {
+        REQUIRE(threads[i].report.summation_ == expected[i]);
+    }
+}
@@ -0,0 +1,44 @@
+from neuron import h
+
+h.load_file("stdrun.hoc")
+pc = h.ParallelContext()
+cvode = h.CVode()
+
+
+def run(somas, tstop):
+    """Returns the soma voltages and hh states at tstop"""
+    h.finitialize(-65)
+    h.continuerun(tstop)
+    return [x for s in somas for x in (s(0.5).v, s(0.5).hh.m, s(0.5).hh.h, s(0.5).hh.n)]
+
+
+def test_nvector_serial_length():
+    # one hh compartment per thread at least, each firing at its own rate
+    somas = [h.Section(name="soma%d" % i) for i in range(8)]
+    stims = []
+    for i, soma in enumerate(somas):
+        soma.insert("hh")
+        stims.append(h.IClamp(soma(0.5)))
+        stims[-1].dur = 1e9
+        stims[-1].amp = 0.1 + 0.02 * i
+    cvode.active(1)
+    default = cvode.nvector_serial_length()
+    assert default > 0
+
+    pc.nthread(4)
+    # every vector operation a job for the threads
+    assert cvode.nvector_serial_length(0) == 0
+    ythread = run(somas, 30)
+
+    # done by the calling thread, the norms are summed in the same thread
+    # order so the results are identical
+    cvode.nvector_serial_length(default)
+    yserial = run(somas, 30)
+    assert yserial == ythread
+
+    pc.nthread(1)
+    cvode.active(0)
+
+
+if __name__ == "__main__":
+    test_nvector_serial_length()
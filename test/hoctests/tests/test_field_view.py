@@ -0,0 +1,85 @@
+import numpy as np
+from neuron import h, nrn
+
+pc = h.ParallelContext()
+
+
+def model(ncell):
+    cells = []
+    for i in range(ncell):
+        soma = h.Section(name="soma%d" % i)
+        soma.L = soma.diam = 20
+        soma.nseg = 1 + i % 3
+        soma.insert("hh")
+        dend = h.Section(name="dend%d" % i)
+        dend.connect(soma(1))
+        dend.nseg = 3
+        dend.insert("pas")
+        syn = h.ExpSyn(dend(0.5))
+        cells.append((soma, dend, syn))
+    return cells
+
+
+def test_field_view():
+    cells = model(10)
+    pc.nthread(2)
+
+    fv = nrn.field_view("hh", "gnabar")
+    a = np.asarray(fv)
+    assert len(a) == len(fv) == sum(c[0].nseg for c in cells)
+    segs = fv.segments()
+    assert len(segs) == len(a)
+    for row, seg in enumerate(segs):
+        assert fv.index(seg) == row
+        assert a[row] == seg.hh.gnabar
+    somasegs = [seg for c in cells for seg in c[0]]
+    rows = fv.index(somasegs)
+    a[rows] = np.arange(len(rows)) * 0.01
+    for i, seg in enumerate(somasegs):
+        assert seg.hh.gnabar == i * 0.01
+
+    # node voltages, in place across finitialize
+    v = np.asarray(nrn.field_view("v"))
+    h.finitialize(-70)
+    assert np.all(v == -70)
+    vf = nrn.field_view("v")
+    for c in cells:
+        for seg in c[1].allseg():
+            assert v[vf.index(seg)] == seg.v
+    v[vf.index(cells[3][1](0.5))] = 10
+    assert cells[3][1](0.5).v == 10
+
+    # point process
+    tau = np.asarray(nrn.field_view("ExpSyn", "tau"))
+    tv = nrn.field_view("ExpSyn", "tau")
+    tau[tv.index([c[2] for c in cells])] = np.arange(1, 11)
+    assert [c[2].tau for c in cells] == list(range(1, 11))
+    tsegs = tv.segments()
+    for c in cells:
+        assert tsegs[tv.index(c[2])] == c[2].get_segment()
+
+    # release only once no array uses the view
+    try:
+        fv.release()
+        assert False
+    except BufferError:
+        pass
+    del a
+    fv.release()
+    try:
+        fv.segments()
+        assert False
+    except ValueError:
+        pass
+
+    # all views gone, the model structure can change again
+    del v, vf, tau, tv, fv
+    cells[0][1].insert("hh")
+    fv = nrn.field_view("hh", "gnabar")
+    assert len(fv) == sum(c[0].nseg for c in cells) + cells[0][1].nseg
+    del fv
+    pc.nthread(1)
+
+
+if __name__ == "__main__":
+    test_field_view()
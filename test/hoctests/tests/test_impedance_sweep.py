@@ -0,0 +1,71 @@
+from neuron import h
+from neuron.expect_hocerr import expect_err
+
+
+def model():
+    soma = h.Section(name="soma")
+    soma.L = soma.diam = 20
+    soma.insert("hh")
+    dends = []
+    for i in range(3):
+        dend = h.Section(name="dend%d" % i)
+        dend.connect(soma(i % 2))
+        dend.nseg = 11 + 4 * i
+        dend.L = 300
+        dend.diam = 1 + i
+        dend.insert("pas")
+        dends.append(dend)
+    return soma, dends
+
+
+def test_sweep():
+    soma, dends = model()
+    h.finitialize(-65)
+    imp = h.Impedance()
+    imp.loc(dends[1](0.3))
+    freqs = h.Vector([0.1, 1, 10, 50, 200, 1000, 5000])
+    segs = [soma(0.5), dends[0](0.2), dends[1](0.3), dends[2](1), dends[0](0.2)]
+    sl = h.SectionList([seg.sec for seg in segs])
+    x = h.Vector([seg.x for seg in segs])
+
+    def ref(nonlin):
+        r = [[], [], [], []]
+        for f in freqs:
+            imp.compute(f, nonlin)
+            r[0].append([imp.transfer(seg) for seg in segs])
+            r[1].append([imp.transfer_phase(seg) for seg in segs])
+            r[2].append([imp.input(seg) for seg in segs])
+            r[3].append([imp.input_phase(seg) for seg in segs])
+        return r
+
+    def chk(ms, r, tol):
+        for m, rm in zip(ms, r):
+            assert m.nrow() == len(freqs) and m.ncol() == len(segs)
+            for i in range(m.nrow()):
+                for j in range(m.ncol()):
+                    assert abs(m.getval(i, j) - rm[i][j]) <= tol * (1 + abs(rm[i][j]))
+
+    # linear, serial and threaded, must be the same as compute
+    r = ref(0)
+    for nt in [1, 3]:
+        assert imp.nthread(nt) == nt
+        ms = [h.Matrix() for _ in range(4)]
+        imp.sweep(freqs, sl, x, *ms)
+        chk(ms, r, 0)
+        tamp, tphase = h.Matrix(), h.Matrix()
+        imp.sweep(freqs, sl, x, tamp, tphase)
+        chk([tamp, tphase], r, 0)
+
+    # extended
+    r = ref(1)
+    ms = [h.Matrix() for _ in range(4)]
+    imp.sweep(freqs, sl, x, *ms, 1)
+    chk(ms, r, 1e-12)
+
+    expect_err("imp.sweep(freqs, sl, h.Vector([0.5] * 6), *ms)")
+    expect_err("imp.sweep(freqs, sl, h.Vector([0.5, 0.5, 2, 0.5, 0.5]), *ms)")
+    imp.nthread(1)
+
+
+if __name__ == "__main__":
+    test_sweep()
@@ -469,11 +469,46 @@ def test_4():
     locals()
 
 
+def test_5():
+    print("test_5")
+    # KSChan.batch gives the same results as the per instance sparse solve.
+    mk_khh("khh5", is_pnt=False)
+    ks = h.ks
+    # a transition that closes the chain into a ring causes LU fill-in
+    tr = ks.add_transition(ks.state(0), ks.state(4))
+    tr.type(0)
+    tr.set_f(0, 3, h.Vector([0.05, 0.1, -55]))
+    tr.set_f(1, 2, h.Vector([0.05, -0.0125, -65]))
+    s, ic = cell()
+    s.nseg = 101  # more instances than one batch block
+    s.insert("khh5")
+    s.gkbar_hh = 0
+    s.gmax_khh5 = 0.036
+
+    def run():
+        h.run()
+        return vrec.c()
+
+    assert ks.batch() == 0
+    for cvode in [0, 1]:
+        h.cvode_active(cvode)
+        ks.batch(0)
+        std = run()
+        assert ks.batch(1) == 1
+        assert run().sub(std).abs().max() < 1e-9
+    ks.batch(0)
+    h.cvode_active(0)
+
+    del s, ic, tr, ks
+    locals()
+
+
 if __name__ == "__main__":
     test_1()
     test_2()
     test_3()
     test_4()
+    test_5()
 
     chk.save()
     print("DONE")
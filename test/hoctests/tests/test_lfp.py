@@ -0,0 +1,119 @@
+import math
+
+import numpy as np
+from neuron import h
+
+h.load_file("stdrun.hoc")
+pc = h.ParallelContext()
+cvode = h.CVode()
+
+
+def model(ncell):
+    cells = []
+    for i in range(ncell):
+        soma = h.Section(name="soma%d" % i)
+        soma.L = soma.diam = 20
+        soma.insert("hh")
+        dend = h.Section(name="dend%d" % i)
+        dend.connect(soma(1))
+        dend.L = 300
+        dend.diam = 2
+        dend.nseg = 11 + i
+        dend.insert("pas")
+        ic = h.IClamp(soma(0.5))
+        ic.delay = 1 + i
+        ic.dur = 1e9
+        ic.amp = 0.3
+        cells.append((soma, dend, ic))
+    h.define_shape()
+    return cells
+
+
+# electrodes around the cells, 17 of them so that the factors span several
+# tiles
+electrodes = [(50.0 + 20 * i, 100.0 - 7 * i, 30.0 + 3 * (i % 4)) for i in range(17)]
+
+
+def expected(imem, line):
+    """Potentials from the recorded i_membrane_ of the segments of the
+    straight sections, as point sources at the segment centers or as line
+    sources, the electrodes being farther than the radius from all of them."""
+    f = 1.0 / (4.0 * math.pi * 0.3)
+    result = np.zeros((imem[0][1][0][1].size(), len(electrodes)))
+    for sec, vec in imem:
+        n = sec.n3d()
+        p0 = np.array([sec.x3d(0), sec.y3d(0), sec.z3d(0)])
+        p1 = np.array([sec.x3d(n - 1), sec.y3d(n - 1), sec.z3d(n - 1)])
+        for k, (x, i) in enumerate(vec):
+            for j, e in enumerate(electrodes):
+                if line:
+                    s0 = p0 + k / sec.nseg * (p1 - p0)
+                    dx = (p1 - p0) / sec.nseg
+                    de = np.array(e) - s0
+                    mu = dx.dot(de) / dx.dot(dx)
+                    length = np.linalg.norm(dx)
+                    q = np.linalg.norm(de - mu * dx) / length
+                    factor = (np.arcsinh((1 - mu) / q) - np.arcsinh(-mu / q)) / length
+                else:
+                    factor = 1 / np.linalg.norm(np.array(e) - (p0 + x * (p1 - p0)))
+                result[:, j] += f * factor * i.as_numpy()
+    return result
+
+
+def run(cells, nthread, cv, method=0, nstep=1):
+    pc.nthread(nthread)
+    cvode.active(cv)
+    xe, ye, ze = (h.Vector([e[k] for e in electrodes]) for k in range(3))
+    lfp = h.LFP(xe, ye, ze, 0.3, method)
+    assert lfp.nelectrode() == len(electrodes)
+    buf = h.Vector()
+    tvec = h.Vector()
+    lfp.record(buf, tvec, nstep)
+    imem = []
+    for soma, dend, ic in cells:
+        for sec in (soma, dend):
+            imem.append(
+                (sec, [(seg.x, h.Vector().record(seg._ref_i_membrane_)) for seg in sec])
+            )
+    h.finitialize(-65)
+    h.continuerun(5)
+    a = buf.as_numpy().reshape(-1, len(electrodes)).copy()
+    assert a.shape[0] == tvec.size()
+    assert lfp.value(3) == a[-1, 3]
+    lfp.record_remove()
+    cvode.active(0)
+    pc.nthread(1)
+    return a, tvec.as_numpy().copy(), imem
+
+
+def test_lfp():
+    cells = model(3)
+    cvode.use_fast_imem(1)
+
+    a, t, imem = run(cells, 1, 0, method=1)
+    assert a.shape[0] == int(5 / h.dt + 0.5) + 1
+    assert t[0] == 0.0
+    assert np.allclose(a, expected(imem, False), rtol=1e-6, atol=1e-12)
+    assert np.abs(a).max() > 0
+
+    # every nstep steps
+    a3, t3, imem = run(cells, 1, 0, method=1, nstep=3)
+    assert np.allclose(a3, a[::3], rtol=1e-12, atol=1e-15)
+    assert np.array_equal(t3, t[::3])
+
+    # threads only change the summation order
+    athread, t, imem = run(cells, 3, 0, method=1)
+    assert np.allclose(athread, a, rtol=1e-12, atol=1e-15)
+
+    aline, t, imem = run(cells, 2, 0)
+    assert np.allclose(aline, expected(imem, True), rtol=1e-6, atol=1e-12)
+
+    # global variable time step
+    acv, t, imem = run(cells, 2, 1, method=1)
+    assert np.allclose(acv, expected(imem, False), rtol=1e-6, atol=1e-12)
+
+    cvode.use_fast_imem(0)
+
+
+if __name__ == "__main__":
+    test_lfp()
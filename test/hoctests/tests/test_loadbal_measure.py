@@ -0,0 +1,73 @@
+import os
+import tempfile
+
+from neuron import h
+
+h.load_file("loadbal.hoc")
+pc = h.ParallelContext()
+
+
+class Cell:
+    # a single compartment, write_balance needs the all SectionList
+    def __init__(self, id):
+        self.id = id
+        self.soma = h.Section(name="soma", cell=self)
+        self.soma.insert("hh" if id % 2 else "pas")
+        self.all = h.SectionList()
+        self.all.wholetree(sec=self.soma)
+        self.ic = h.IClamp(self.soma(0.5))
+        self.ic.dur = 1e9
+        self.ic.amp = 0.01 * id
+
+    def __str__(self):
+        return "Cell_" + str(self.id)
+
+
+def run(tstop):
+    h.stdinit()
+    h.continuerun(tstop)
+
+
+def test_measure():
+    ncell = 8
+    cells = [Cell(i) for i in range(ncell)]
+    for i, cell in enumerate(cells):
+        pc.set_gid2node(i, pc.id())
+        pc.cell(i, h.NetCon(cell.soma(0.5)._ref_v, None, sec=cell.soma))
+    vrec = h.Vector().record(cells[7].soma(0.5)._ref_v, sec=cells[7].soma)
+
+    pc.nthread(4)
+    run(20)
+    vstd = vrec.c()
+
+    lb = h.LoadBalance()
+    lb.thread_rebalance(5)
+    # the mechanisms in the model have a measured cost
+    for j, names in enumerate((("capacitance", "hh", "pas"), ("IClamp",))):
+        mt = h.MechanismType(j)
+        for name in names:
+            mt.select(name)
+            assert lb.m_complex_[j].x[mt.selected()] > 0
+    # every cell on exactly one thread
+    roots = []
+    for ith in range(pc.nthread()):
+        roots.extend(sec for sec in pc.get_partition(ith))
+    assert sorted(sec.cell().id for sec in roots) == list(range(ncell))
+
+    # the partition does not change the result
+    run(20)
+    assert vrec.eq(vstd)
+
+    # balance file for the next run
+    fname = os.path.join(tempfile.mkdtemp(), "balance.dat")
+    lb.write_balance(fname, h.Vector(range(ncell)))
+    gids = lb.balance_gids(fname)
+    assert list(gids) == list(range(ncell))
+    os.remove(fname)
+
+    pc.gid_clear()
+    pc.nthread(1)
+
+
+if __name__ == "__main__":
+    test_measure()
@@ -0,0 +1,64 @@
+from neuron import h
+
+pc = h.ParallelContext()
+
+phases = [
+    "deliver-events",
+    "setup-tree-matrix",
+    "matrix-solver",
+    "second-order-cur",
+    "update",
+    "state-update",
+    "record",
+]
+
+
+def test_phase_time():
+    cells = []
+    for i in range(8):
+        s = h.Section(name="soma%d" % i)
+        s.nseg = 11
+        s.insert("hh")
+        cells.append(s)
+    pc.nthread(2)
+    pc.phase_time()
+    h.finitialize(-65)
+    pc.psolve(20)
+    hh = h.MechanismType(0)
+    hh.select("hh")
+    for ith in range(2):
+        for p in phases:
+            assert pc.phase_time(ith, p) >= 0.0
+        assert pc.phase_time(ith, "matrix-solver") > 0.0
+        assert pc.phase_time(ith, "cur", "hh") > 0.0
+        assert pc.phase_time(ith, "state", "hh") > 0.0
+        assert pc.phase_time(ith, "cur", "hh") == pc.phase_time(
+            ith, "cur", hh.internal_type()
+        )
+
+    # zeroed when re-enabled
+    pc.phase_time()
+    assert pc.phase_time(0, "matrix-solver") == 0.0
+
+    # no accumulation when off
+    pc.phase_time(-1)
+    pc.psolve(30)
+    assert pc.phase_time(0, "matrix-solver") == 0.0
+
+    for args in [
+        (0,),
+        (0, "nophase"),
+        (0, "other", "hh"),
+        (0, "cur", "nomech"),
+        (2, "update"),
+    ]:
+        try:
+            pc.phase_time(*args)
+            assert False
+        except RuntimeError:
+            pass
+    pc.nthread(1)
+
+
+if __name__ == "__main__":
+    test_phase_time()
@@ -0,0 +1,109 @@
+import os
+import tempfile
+
+import numpy as np
+from neuron import h
+
+h.load_file("stdrun.hoc")
+pc = h.ParallelContext()
+
+
+def model(ncell):
+    cells = []
+    for i in range(ncell):
+        soma = h.Section(name="soma%d" % i)
+        soma.L = soma.diam = 20
+        soma.insert("hh")
+        dend = h.Section(name="dend%d" % i)
+        dend.connect(soma(1))
+        dend.nseg = 3 + i
+        dend.insert("pas")
+        ic = h.IClamp(soma(0.5))
+        ic.delay = 1 + i
+        ic.dur = 1e9
+        ic.amp = 0.3
+        cells.append((soma, dend, ic))
+    return cells
+
+
+def refs(cells):
+    r = []
+    for soma, dend, ic in cells:
+        r += [soma(0.5)._ref_v, soma(0.5).hh._ref_m, ic._ref_i]
+        r += [seg._ref_v for seg in dend]
+    return r
+
+
+def run(cells, nthread, cvode, fname=None, chunk=0):
+    pc.nthread(nthread)
+    h.cvode_active(cvode)
+    r = refs(cells)
+    pv = h.PtrVector(len(r))
+    vecs = []
+    for i, ref in enumerate(r):
+        pv.pset(i, ref)
+        vecs.append(h.Vector().record(ref))
+    buf = h.Vector()
+    if fname:
+        pv.record(buf, fname, chunk)
+    else:
+        pv.record(buf)
+    h.finitialize(-65)
+    h.continuerun(5)
+    pv.record_flush()
+    if fname:
+        a = np.fromfile(fname, dtype=np.float64)
+        assert buf.size() == 0
+    else:
+        a = buf.as_numpy()
+    a = a.reshape(-1, len(r))
+    ref = np.array([v.as_numpy() for v in vecs]).T
+    assert a.shape == ref.shape
+    assert np.array_equal(a, ref)
+    pv.record_remove()
+    h.cvode_active(0)
+    pc.nthread(1)
+    return a
+
+
+def test_record():
+    cells = model(4)
+    std = run(cells, 1, 0)
+    assert std.shape[0] == int(5 / h.dt + 0.5) + 1
+    assert np.array_equal(run(cells, 3, 0), std)
+    run(cells, 1, 1)
+    run(cells, 2, 1)
+    fname = os.path.join(tempfile.mkdtemp(), "ptrvec.dat")
+    assert np.array_equal(run(cells, 1, 0, fname, 7), std)
+    assert np.array_equal(run(cells, 3, 0, fname, 7), std)
+    os.remove(fname)
+
+
+def test_record_resize():
+    cells = model(4)
+    pc.nthread(3)
+    r = refs(cells)
+    pv = h.PtrVector(len(r))
+    for i, ref in enumerate(r):
+        pv.pset(i, ref)
+    buf = h.Vector()
+    pv.record(buf)
+    h.finitialize(-65)
+    h.continuerun(1)
+    nrow = buf.size() // len(r)
+    assert buf.size() == nrow * len(r)
+    # recording stops, the rows so far are kept
+    pv.resize(3)
+    h.continuerun(2)
+    assert buf.size() == nrow * len(r)
+    # and resumes with the new size at the next finitialize
+    h.finitialize(-65)
+    h.continuerun(1)
+    assert buf.size() == nrow * 3
+    pv.record_remove()
+    pc.nthread(1)
+
+
+if __name__ == "__main__":
+    test_record()
+    test_record_resize()
@@ -0,0 +1,71 @@
+from neuron import h
+
+pc = h.ParallelContext()
+
+
+class Cell:
+    def __init__(self, id):
+        self.id = id
+        self.soma = h.Section(name="soma", cell=self)
+        self.soma.L = self.soma.diam = 20
+        self.soma.insert("hh")
+        # heterogeneous cost, some cells have long dendrites
+        self.dend = h.Section(name="dend", cell=self)
+        self.dend.connect(self.soma(1))
+        self.dend.nseg = 1 + 20 * (id % 4)
+        self.dend.insert("hh")
+        self.ic = h.IClamp(self.soma(0.5))
+        self.ic.dur = 1e9
+        self.ic.amp = 0.1 + 0.02 * id
+        self.syn = h.ExpSyn(self.soma(0.5))
+
+    def __str__(self):
+        return "Cell_" + str(self.id)
+
+
+def run(tstop):
+    pc.set_maxstep(10)
+    h.finitialize(-65)
+    pc.psolve(tstop)
+
+
+def test_dynamic():
+    cells = [Cell(i) for i in range(16)]
+    ncs = [
+        h.NetCon(cells[i].soma(0.5)._ref_v, cells[(i + 1) % 16].syn, 0, 1 + i * 0.1, 0.01)
+        for i in range(16)
+    ]
+    spikes = h.Vector()
+    gids = h.Vector()
+    for i, nc in enumerate(ncs):
+        nc.record(spikes, gids, i)
+    vrec = h.Vector().record(cells[5].soma(0.5)._ref_v, sec=cells[5].soma)
+
+    pc.nthread(8)
+    # without thread support there are no worker threads
+    threads_enabled = pc.nworker() > 0
+    assert pc.nworker() == (8 if threads_enabled else 0)
+    assert pc.thread_dynamic() == 0
+    run(50)
+    vstd = vrec.c()
+    # spikes from different threads may be recorded in any order
+    sstd = spikes.c().sort()
+    assert sstd.size() > 0
+
+    assert pc.thread_dynamic(3) == 3
+    assert pc.nworker() == (3 if threads_enabled else 0)
+    run(50)
+    assert vrec.eq(vstd)
+    assert spikes.c().sort().eq(sstd)
+
+    # not meaningful unless fewer workers than threads
+    assert pc.thread_dynamic(8) == 0
+    run(50)
+    assert vrec.eq(vstd)
+
+    pc.thread_dynamic(0)
+    pc.nthread(1)
+
+
+if __name__ == "__main__":
+    test_dynamic()
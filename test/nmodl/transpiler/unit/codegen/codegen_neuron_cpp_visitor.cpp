@@ -130,10 +130,11 @@ std::string create_mod_file_read(const std::string& var) {
     return fmt::format(pattern, var);
 }
 
-std::string transpile(const std::string& nmodl) {
+std::string transpile(const std::string& nmodl, bool simd = false) {
     const auto& ast = NmodlDriver().parse_string(nmodl);
     std::stringstream ss;
     auto cvisitor = create_neuron_cpp_visitor(ast, nmodl, ss);
+    cvisitor->set_simd(simd);
     cvisitor->visit_program(*ast);
 
     return ss.str();
@@ -248,3 +249,91 @@ SCENARIO("ARTIFICIAL_CELL with `net_move`") {
         }
     }
 }
+
+SCENARIO("SIMD code generation", "[codegen][simd]") {
+    GIVEN("a density mechanism calling exp from a FUNCTION") {
+        std::string nmodl = R"(
+            NEURON {
+                SUFFIX test
+                NONSPECIFIC_CURRENT il
+                RANGE g
+            }
+            PARAMETER {
+                g = 0.001
+            }
+            STATE {
+                m
+            }
+            ASSIGNED {
+                v
+                il
+            }
+            BREAKPOINT {
+                SOLVE states METHOD cnexp
+                il = g * m * v
+            }
+            DERIVATIVE states {
+                m' = (rate(v) - m) / 5
+            }
+            FUNCTION rate(x) {
+                rate = 1 / (1 + exp(-x / 10))
+            }
+        )";
+
+        THEN("with codegen --simd the kernels and functions are annotated") {
+            std::string cpp = transpile(nmodl, true);
+            REQUIRE_THAT(cpp, ContainsSubstring("static inline double nrn_simd_exp(double x)"));
+            REQUIRE_THAT(cpp, ContainsSubstring("nrn_simd_exp(-x / 10"));
+            REQUIRE_THAT(cpp, ContainsSubstring("#pragma omp declare simd uniform("));
+            REQUIRE_THAT(cpp, ContainsSubstring("linear(id:1)"));
+            REQUIRE_THAT(cpp, ContainsSubstring("#pragma omp simd"));
+        }
+
+        THEN("without it the code is unchanged") {
+            std::string cpp = transpile(nmodl);
+            REQUIRE_THAT(cpp, !ContainsSubstring("nrn_simd_exp"));
+            REQUIRE_THAT(cpp, !ContainsSubstring("#pragma omp"));
+        }
+    }
+    GIVEN("a THREADSAFE mechanism assigning a GLOBAL, as minf in hh") {
+        std::string nmodl = R"(
+            NEURON {
+                SUFFIX test
+                NONSPECIFIC_CURRENT il
+                RANGE g
+                GLOBAL minf
+                THREADSAFE
+            }
+            PARAMETER {
+                g = 0.001
+            }
+            STATE {
+                m
+            }
+            ASSIGNED {
+                v
+                il
+                minf
+            }
+            BREAKPOINT {
+                SOLVE states METHOD cnexp
+                il = g * m * v
+            }
+            DERIVATIVE states {
+                rates(v)
+                m' = (minf - m) / 5
+            }
+            PROCEDURE rates(x) {
+                minf = 1 / (1 + exp(-x / 10))
+            }
+        )";
+
+        THEN("with codegen --simd the kernels and functions are not annotated") {
+            std::string cpp = transpile(nmodl, true);
+            // minf is one value per thread, which the lanes would share
+            REQUIRE_THAT(cpp, ContainsSubstring("minf(size_t id)"));
+            REQUIRE_THAT(cpp, !ContainsSubstring("#pragma omp simd"));
+            REQUIRE_THAT(cpp, !ContainsSubstring("#pragma omp declare simd uniform("));
+        }
+    }
+}
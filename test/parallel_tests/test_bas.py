@@ -16,6 +16,7 @@ def rmfiles():
         subprocess.run("rm -f state*.bin", shell=True)
         subprocess.run("rm -r -f bbss_out", shell=True)
         subprocess.run("rm -r -f in", shell=True)
+        subprocess.run("rm -r -f bbss_bin", shell=True)
     pc.barrier()
 
 
@@ -276,6 +277,9 @@ def prun(tstop, restore=False):
         cp_out_to_in()  # prepare for restore.
         bbss = h.BBSaveState()
         bbss.restore_test()
+    elif restore == "BBSaveStateBin":
+        bbss = h.BBSaveState()
+        bbss.restore_bin("bbss_bin")
     else:
         pc.psolve(tstop / 2)
 
@@ -294,7 +298,14 @@ def prun(tstop, restore=False):
             bbss = None
         assert h.List("PythonObject").count() == cnt
 
+        # parallel binary BBSaveState, written while the simulation continues
+        bbss = h.BBSaveState()
+        assert bbss.save_bin("bbss_bin") > 0
+
     pc.psolve(tstop)
+    if not restore:
+        bbss.save_wait()
+        pc.barrier()
 
 
 def get_all_spikes(ring):
@@ -377,6 +388,9 @@ def test_bas():
     prun(200 * ms, "BBSaveState")  # BBSaveState restore to start at t = tstop/2
     compare_dicts(get_all_spikes(ring), stdspikes_after_100)
 
+    prun(200 * ms, "BBSaveStateBin")  # binary restore to start at t = tstop/2
+    compare_dicts(get_all_spikes(ring), stdspikes_after_100)
+
 
 def test_starnet():
     pc.gid_clear()
@@ -390,6 +404,8 @@ def test_starnet():
         stdspikes_half[gid] = [spk_t for spk_t in stdspikes[gid] if spk_t >= tstop / 2]
     prun(tstop, "BBSaveState")  # BBSaveState restore to start at t = tstop/2
     compare_dicts(get_all_spikes(starnet), stdspikes_half)
+    prun(tstop, "BBSaveStateBin")
+    compare_dicts(get_all_spikes(starnet), stdspikes_half)
 
     # test for binq mode.
     h.CVode().queue_mode(1)
@@ -0,0 +1,78 @@
+# The pc.spike_compress xchng_meth variants of spike exchange must give the
+# same spikes as Allgather.
+# Run with mpiexec -n 4 nrniv -mpi -python test_spike_exchange_methods.py
+
+from neuron import h
+
+pc = h.ParallelContext()
+rank = int(pc.id())
+nhost = int(pc.nhost())
+ncell = 16
+
+
+class Cell:
+    def __init__(self, gid):
+        self.gid = gid
+        self.soma = h.Section(name="soma", cell=self)
+        self.soma.L = self.soma.diam = 20
+        self.soma.insert("hh")
+        self.ic = h.IClamp(self.soma(0.5))
+        self.ic.dur = 1e9
+        self.ic.amp = 0.05 + 0.01 * gid
+        self.syn = h.ExpSyn(self.soma(0.5))
+        pc.set_gid2node(gid, rank)
+        pc.cell(gid, h.NetCon(self.soma(0.5)._ref_v, None, sec=self.soma))
+
+    def __str__(self):
+        return "Cell_" + str(self.gid)
+
+
+def mknet():
+    # sparse fan-out, each rank talks to only some of the others
+    cells = {gid: Cell(gid) for gid in range(rank, ncell, nhost)}
+    ncs = []
+    for gid, cell in cells.items():
+        for src in [(gid + 1) % ncell, (gid + 5) % ncell]:
+            nc = pc.gid_connect(src, cell.syn)
+            nc.delay = 1.0 + 0.1 * src
+            nc.weight[0] = 0.002
+            ncs.append(nc)
+    return cells, ncs
+
+
+def run(xchng_meth, tstop=100):
+    pc.spike_compress(0, 0, xchng_meth)
+    tvec = h.Vector()
+    idvec = h.Vector()
+    pc.spike_record(-1, tvec, idvec)
+    pc.set_maxstep(10)
+    h.finitialize(-65)
+    pc.psolve(tstop)
+    spikes = sorted(zip(idvec, tvec))
+    allspikes = pc.py_allgather(spikes)
+    return sorted(s for r in allspikes for s in r)
+
+
+def test_spike_exchange_methods():
+    cells, ncs = mknet()
+    std = run(0)
+    assert len(std) > 0
+    # multisend, neighbor collective, with two subintervals, overlapped allgather
+    for xchng_meth in [1, 17, 21, 32]:
+        spikes = run(xchng_meth)
+        assert len(spikes) == len(std)
+        for a, b in zip(spikes, std):
+            assert a[0] == b[0] and abs(a[1] - b[1]) < 1e-10
+        if nhost > 1:
+            # bits 7 and 8 of the method properties report the neighbor
+            # and overlapped exchange
+            assert bool(int(pc.send_time(8)) & 128) == bool(xchng_meth & 16)
+            assert bool(int(pc.send_time(8)) & 256) == bool(xchng_meth & 32)
+    pc.spike_compress(0, 0, 0)
+    pc.gid_clear()
+
+
+if __name__ == "__main__":
+    test_spike_exchange_methods()
+    pc.barrier()
+    h.quit()
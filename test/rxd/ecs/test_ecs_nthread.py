@@ -0,0 +1,49 @@
+import pytest
+
+from neuron import nrn_dll_sym
+
+
+@pytest.fixture
+def ecs_nthread(neuron_nosave_instance):
+    h, rxd, save_path = neuron_nosave_instance
+    h("create dummy")
+    dx = 5
+    ecs = rxd.Extracellular(-100, -100, -100, 100, 100, 100, dx=dx)
+    k = rxd.Species(
+        [ecs],
+        name="k",
+        d=1,
+        charge=1,
+        initial=lambda nd: (
+            1 if nd.x3d**2 + nd.y3d**2 + nd.z3d**2 < (4 * dx) ** 2 else 0
+        ),
+    )
+    decay = rxd.Rate(k, -0.1 * k)
+    pc = h.ParallelContext()
+    yield (h, rxd, pc, k)
+    pc.nthread(1)
+    rxd.nthread(1)
+
+
+def test_ecs_tasks_with_nthread(ecs_nthread):
+    """rxd tasks use the worker threads with NrnThread parallelism."""
+
+    h, rxd, pc, k = ecs_nthread
+    max_nparticipant = nrn_dll_sym("rxd_max_nparticipant")
+
+    def run():
+        h.finitialize(-65)
+        max_nparticipant()
+        h.continuerun(1)
+        return [nd.value for nd in k.nodes[::97]], max_nparticipant()
+
+    rxd.nthread(4)
+    ref, _ = run()
+
+    pc.nthread(4)
+    threads_enabled = pc.nworker() > 0
+    values, nparticipant = run()
+    # the rxd solve is done once per step, by the main thread between the
+    # thread jobs, and not by each NrnThread
+    assert values == ref
+    assert nparticipant > 1 if threads_enabled else nparticipant == 1
@@ -0,0 +1,117 @@
+#include "multicore.h"
+#include "tqueue.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+// Insert, move and remove the same events in a splay tree and a calendar
+// queue TQueue and return the order in which they are delivered.
+std::vector<std::intptr_t> delivery_order(bool calendar) {
+    nrn_use_calendar_queue_ = calendar;
+    TQItemPool pool(1000);
+    TQueue tq(&pool);
+    nrn_use_calendar_queue_ = false;
+    REQUIRE(tq.least() == nullptr);
+    std::mt19937 gen(42);
+    // many events with the same time, as from delays that are multiples of dt
+    std::uniform_int_distribution<int> steps(0, 400);
+    std::vector<TQItem*> items;
+    for (std::intptr_t i = 1; i <= 20000; ++i) {
+        items.push_back(tq.insert(0.025 * steps(gen), reinterpret_cast<void*>(i)));
+    }
+    for (std::size_t i = 0; i < items.size(); i += 7) {
+        tq.remove(items[i]);
+        items[i] = nullptr;
+    }
+    for (std::size_t i = 3; i < items.size(); i += 7) {
+        tq.move(items[i], items[i]->t_ + 0.5);
+    }
+    REQUIRE(tq.find(1e9) == nullptr);
+    std::vector<std::intptr_t> order;
+    double tlast = -1.0;
+    double t = 0.0;
+    while (tq.least()) {
+        t += 0.1;
+        while (TQItem* q = tq.atomic_dq(t)) {
+            REQUIRE(q->t_ >= tlast);
+            tlast = q->t_;
+            order.push_back(reinterpret_cast<std::intptr_t>(q->data_));
+            // interleave new events with the deliveries
+            if (order.size() % 3 == 0) {
+                tq.insert(t + 0.025 * steps(gen),
+                          reinterpret_cast<void*>(std::intptr_t(100000 + order.size())));
+            }
+            tq.release(q);
+        }
+    }
+    return order;
+}
+
+TQItemPool* remote_pool;
+std::vector<TQItem*> remote_items;
+void* free_remote_items(NrnThread* nt) {
+    if (nt->id == 1) {
+        for (auto* q: remote_items) {
+            remote_pool->hpfree(q);
+        }
+    }
+    return nullptr;
+}
+}  // namespace
+
+TEST_CASE("Calendar queue delivers in splay tree order", "[NEURON][tqueue]") {
+    auto splay = delivery_order(false);
+    auto calendar = delivery_order(true);
+    REQUIRE(splay.size() > 20000);
+    REQUIRE(calendar == splay);
+}
+
+TEST_CASE("Thread owned TQItem pool", "[NEURON][tqueue]") {
+    TQItemPool pool(100);
+    REQUIRE(pool.size() == 0);
+    std::vector<TQItem*> items;
+    for (int i = 0; i < 250; ++i) {
+        items.push_back(pool.alloc());
+    }
+    // chunks of 100, 100, 200
+    REQUIRE(pool.size() == 400);
+    REQUIRE(pool.maxget() == 250);
+    REQUIRE(pool.nalloc() == 250);
+    for (auto* q: items) {
+        pool.hpfree(q);
+    }
+    // reused, no growth
+    for (int i = 0; i < 250; ++i) {
+        pool.alloc();
+    }
+    REQUIRE(pool.size() == 400);
+    pool.free_all();
+    pool.clear_counters();
+    REQUIRE(pool.maxget() == 0);
+
+    SECTION("Free from another NrnThread") {
+        nrn_threads_create(2, true);
+        remote_pool = &pool;
+        remote_items.clear();
+        for (int i = 0; i < 400; ++i) {
+            remote_items.push_back(pool.alloc());
+        }
+        nrn_multithread_job(free_remote_items);
+        // deferred if there are worker threads. Either way reused by the owner.
+#if NRN_ENABLE_THREADS
+        REQUIRE(pool.nremote_free() == 400);
+#else
+        REQUIRE(pool.nremote_free() == 0);
+#endif
+        for (int i = 0; i < 400; ++i) {
+            pool.alloc();
+        }
+        REQUIRE(pool.size() == 400);
+        pool.free_all();
+        nrn_threads_create(1, false);
+    }
+}
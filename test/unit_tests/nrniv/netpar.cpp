@@ -0,0 +1,82 @@
+#include "netpar.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+
+namespace {
+// The index only stores the pointers, so fake ones will do.
+PreSyn* fake_presyn(int gid) {
+    return reinterpret_cast<PreSyn*>(std::uintptr_t(gid + 1) * 64);
+}
+
+void check(Gid2PreSynIndex const& index, Gid2PreSyn const& map) {
+    REQUIRE(index.size() == map.size());
+    for (auto const& [gid, ps]: map) {
+        REQUIRE(index.find(gid) == ps);
+    }
+}
+}  // namespace
+
+TEST_CASE("Gid2PreSynIndex", "[NEURON][netpar]") {
+    Gid2PreSynIndex index;
+    REQUIRE(index.size() == 0);
+    REQUIRE(index.find(0) == nullptr);
+
+    SECTION("Dense gids, direct table") {
+        Gid2PreSyn map;
+        for (int gid = 100; gid < 1100; gid += 2) {
+            map[gid] = fake_presyn(gid);
+        }
+        index.build(map);
+        check(index, map);
+        REQUIRE(index.find(101) == nullptr);
+        REQUIRE(index.find(99) == nullptr);
+        REQUIRE(index.find(1100) == nullptr);
+        REQUIRE(index.find(-1) == nullptr);
+
+        map.erase(100);
+        map.erase(500);
+        map[5000] = fake_presyn(5000);
+        index.build(map);
+        check(index, map);
+        REQUIRE(index.find(100) == nullptr);
+        REQUIRE(index.find(500) == nullptr);
+    }
+
+    SECTION("Sparse gids, binary search") {
+        Gid2PreSyn map;
+        for (int gid = 7; gid < 100000000; gid *= 3) {
+            map[gid] = fake_presyn(gid);
+        }
+        index.build(map);
+        check(index, map);
+        REQUIRE(index.find(8) == nullptr);
+        REQUIRE(index.find(6) == nullptr);
+        REQUIRE(index.find(100000000) == nullptr);
+
+        map.erase(63);
+        index.build(map);
+        check(index, map);
+        REQUIRE(index.find(63) == nullptr);
+    }
+
+    SECTION("Null PreSyn entries are not indexed") {
+        Gid2PreSyn map{{1, fake_presyn(1)}, {2, nullptr}, {3, fake_presyn(3)}};
+        index.build(map);
+        REQUIRE(index.size() == 2);
+        REQUIRE(index.find(1) == fake_presyn(1));
+        REQUIRE(index.find(2) == nullptr);
+        REQUIRE(index.find(3) == fake_presyn(3));
+    }
+
+    SECTION("Clear") {
+        index.build({{42, fake_presyn(42)}});
+        REQUIRE(index.find(42) == fake_presyn(42));
+        index.clear();
+        REQUIRE(index.size() == 0);
+        REQUIRE(index.find(42) == nullptr);
+        index.build({});
+        REQUIRE(index.find(42) == nullptr);
+    }
+}
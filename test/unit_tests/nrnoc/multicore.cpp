@@ -0,0 +1,64 @@
+#include "multicore.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <vector>
+
+namespace {
+struct Counter {
+    std::atomic<int> n{0};
+};
+void* count(void* v) {
+    ++static_cast<Counter*>(v)->n;
+    return nullptr;
+}
+std::atomic<int> njob{0};
+void* count_job(NrnThread*) {
+    ++njob;
+    return nullptr;
+}
+}  // namespace
+
+TEST_CASE("Tasks on the NrnThread worker threads", "[NEURON][multicore]") {
+    std::vector<Counter> counters(1000);
+    auto check = [&counters] {
+        for (auto& c: counters) {
+            c.n = 0;
+        }
+        nrn_multitask(counters.size(), count, counters.data());
+        for (auto& c: counters) {
+            REQUIRE(c.n == 1);
+        }
+    };
+    // no worker threads
+    check();
+    SECTION("Shared with NrnThread jobs") {
+        nrn_threads_create(4, true);
+        auto const nworker = nof_worker_threads();
+        // at least as many workers as requested, the NrnThread workers are reused
+        nrn_multitask_nworker(2);
+        REQUIRE(nof_worker_threads() == nworker);
+        check();
+        nrn_multitask_nworker(6);
+#if NRN_ENABLE_THREADS
+        REQUIRE(nof_worker_threads() == 6);
+#endif
+        check();
+        njob = 0;
+        nrn_multithread_job(count_job);
+        REQUIRE(njob == 4);
+        nrn_multitask_nworker(1);
+        REQUIRE(nof_worker_threads() == nworker);
+        nrn_threads_create(1, false);
+    }
+    SECTION("Without NrnThread parallelism") {
+        nrn_multitask_nworker(3);
+#if NRN_ENABLE_THREADS
+        REQUIRE(nof_worker_threads() == 3);
+#endif
+        check();
+        nrn_multitask_nworker(1);
+        REQUIRE(nof_worker_threads() == 0);
+    }
+}
@@ -0,0 +1,83 @@
+#include "spconfig.h"
+#include "spmatrix.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+// Structure of a cell-like tree of n nodes plus a few extra couplings, as
+// added by extracellular or LinearMechanism.
+std::vector<std::pair<int, int>> couplings(int n) {
+    std::vector<std::pair<int, int>> c;
+    for (int i = 2; i <= n; ++i) {
+        c.emplace_back(i, (i % 5 == 0) ? i / 2 : i - 1);
+    }
+    for (int i = 7; i <= n / 2; i += 11) {
+        c.emplace_back(i, n - i + 1);
+    }
+    return c;
+}
+
+// Factor and solve with new values nrefactor times and return all the
+// solutions. As in NEURON, the element pointers are obtained once and the
+// values are set through them before each factorization.
+std::vector<double> solve(bool compiled, int nrefactor) {
+    int const n = 200;
+    int err;
+    char* mat = spCreate(n, 0, &err);
+    auto const c = couplings(n);
+    std::vector<double*> diag(n + 1);
+    std::vector<std::pair<double*, double*>> off;
+    for (int i = 1; i <= n; ++i) {
+        diag[i] = spGetElement(mat, i, i);
+    }
+    for (auto const& [i, j]: c) {
+        off.emplace_back(spGetElement(mat, i, j), spGetElement(mat, j, i));
+    }
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> val(-1.0, -0.1);
+    std::uniform_real_distribution<double> rhs(-1.0, 1.0);
+    std::vector<double> b(n + 1), result;
+    for (int k = 0; k < nrefactor; ++k) {
+        spClear(mat);
+        for (int i = 1; i <= n; ++i) {
+            *diag[i] = 10.0;
+        }
+        for (std::size_t m = 0; m < c.size(); ++m) {
+            double a = val(gen);
+            *off[m].first = a;
+            *off[m].second = a;
+            *diag[c[m].first] -= a;
+            *diag[c[m].second] -= a;
+        }
+        for (int i = 1; i <= n; ++i) {
+            b[i] = (i % 3) ? rhs(gen) : 0.0;
+        }
+        REQUIRE((compiled ? spFactorCompiled(mat) : spFactor(mat)) == spOKAY);
+        if (compiled) {
+            spSolveCompiled(mat, b.data(), b.data());
+        } else {
+            spSolve(mat, b.data(), b.data());
+        }
+        result.insert(result.end(), b.begin() + 1, b.end());
+    }
+    spDestroy(mat);
+    return result;
+}
+}  // namespace
+
+TEST_CASE("Compiled sparse13 factorization", "[sparse13]") {
+    GIVEN("A tree matrix with extra couplings refactored with new values") {
+        THEN("The compiled schedule gives the same solutions as spFactor and spSolve") {
+            auto const expected = solve(false, 5);
+            auto const result = solve(true, 5);
+            REQUIRE(result.size() == expected.size());
+            for (std::size_t i = 0; i < result.size(); ++i) {
+                REQUIRE(result[i] == expected[i]);
+            }
+        }
+    }
+}